@@ -0,0 +1,83 @@
+#include "BenchHarness.hpp"
+#include "Simulation/CommonSimParams.hpp"
+#include "Simulation/SimObjects/KinematicStatePool.hpp"
+#include "Simulation/SimObjects/Missile.hpp"
+#include "Simulation/SimObjects/Target.hpp"
+
+#include <QString>
+#include <QVector2D>
+#include <array>
+#include <unordered_map>
+
+// сравнивает доступ к действующим векторам по строковому ключу (как было) с доступом по ячейкам и с пулом в виде структуры массивов
+
+namespace
+{
+	constexpr std::size_t poolObjectCount = 1024;
+
+	struct LegacyObject // прежняя раскладка - векторы в хеш-таблице по строковому ключу
+	{
+		std::unordered_map<QString, QVector2D> actingVectors{ { "velocity", QVector2D(0, 300) }, { "acceleration", QVector2D(1, 0) } };
+		QVector2D coordinates;
+	};
+
+	struct SlotObject // новая раскладка - векторы в массиве по индексу, известному при компиляции
+	{
+		std::array<Vec2d, 2> actingVectors{ Vec2d(0, 300), Vec2d(1, 0) };
+		Vec2d coordinates;
+	};
+
+	// те же обращения, что делает Missile::basicMove за один такт: приращение скорости, перемещение и два вычисления модуля скорости
+	void legacyTick(LegacyObject& object)
+	{
+		float speed = object.actingVectors.at("velocity").length();
+		float dynPressureSpeed = object.actingVectors.at("velocity").length();
+		object.actingVectors.at("velocity") += object.actingVectors.at("velocity").normalized() * (SIM_RESOLUTION * (speed - dynPressureSpeed) * 1e-3f);
+		object.coordinates += object.actingVectors.at("velocity") * SIM_RESOLUTION;
+	}
+
+	void slotTick(SlotObject& object)
+	{
+		auto& velocity = std::get<0>(object.actingVectors);
+		double speed = velocity.length();
+		double dynPressureSpeed = velocity.length();
+		velocity += velocity.normalized() * (SIM_RESOLUTION * (speed - dynPressureSpeed) * 1e-3);
+		object.coordinates += velocity * SIM_RESOLUTION;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	Bench::Suite suite(argc, argv);
+	LegacyObject legacyObject;
+	SlotObject slotObject;
+	Missile leMsl(300, 0, 0);
+	Target leTgt(300, 0, 1e5);
+	std::vector<LegacyObject> legacyObjects(poolObjectCount);
+	KinematicStatePool pool;
+
+	pool.reserve(poolObjectCount);
+
+	for (std::size_t i = 0; i < poolObjectCount; ++i)
+		pool.add(0, double(i), 0, 300, 1, 0);
+
+	suite.add("tick/legacy_string_keyed_map", [&] { legacyTick(legacyObject); Bench::doNotOptimize(legacyObject.coordinates); });
+	suite.add("tick/fixed_slots", [&] { slotTick(slotObject); Bench::doNotOptimize(slotObject.coordinates); });
+	suite.add("Missile::basicMove", [&] { leMsl.basicMove(SIM_RESOLUTION, 0); Bench::doNotOptimize(leMsl.getCoordinates()); });
+	suite.add("Target::basicMove", [&] { leTgt.basicMove(SIM_RESOLUTION); Bench::doNotOptimize(leTgt.getCoordinates()); });
+
+	suite.add("pool_1024/legacy_string_keyed_map", [&]
+	{
+		for (auto& object : legacyObjects)
+		{
+			auto& velocity = object.actingVectors.at("velocity");
+			object.coordinates += velocity * SIM_RESOLUTION + object.actingVectors.at("acceleration") * (0.5f * SIM_RESOLUTION * SIM_RESOLUTION);
+			velocity += object.actingVectors.at("acceleration") * SIM_RESOLUTION;
+		}
+
+		Bench::doNotOptimize(legacyObjects.front().coordinates);
+	});
+	suite.add("pool_1024/struct_of_arrays", [&] { pool.advance(SIM_RESOLUTION); Bench::doNotOptimize(pool.data<KinematicStatePool::XColumn>()[0]); });
+
+	return suite.finish();
+}
@@ -0,0 +1,243 @@
+#ifndef BENCH_HARNESS_HDR_IG
+#define BENCH_HARNESS_HDR_IG
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Bench
+{
+	struct Result // итог замера одного тела
+	{
+		std::string name;
+		std::uint64_t iterations{ 0 };
+		double nsPerIteration{ 0 };
+	};
+
+	template <typename T> inline void doNotOptimize(T&& value) // не даёт компилятору выбросить вычисление, результат которого не используется
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		static volatile char sink;
+		sink = *reinterpret_cast<const volatile char*>(&value);
+#endif
+	}
+
+	template <typename Body> Result run(const std::string& name, Body&& body, double minSeconds = 0.25) // удваивает число итераций, пока замер не займёт minSeconds
+	{
+		using Clock = std::chrono::steady_clock;
+		std::uint64_t iterations = 1;
+
+		while (true)
+		{
+			auto startTime = Clock::now();
+
+			for (std::uint64_t i = 0; i < iterations; ++i)
+				body();
+
+			std::chrono::duration<double> elapsed = Clock::now() - startTime;
+
+			if (elapsed.count() >= minSeconds || iterations >= (1ull << 40))
+				return { name, iterations, elapsed.count() * 1e9 / iterations };
+
+			iterations *= 2;
+		}
+	}
+
+	struct Options // ключи командной строки - названия как у Google Benchmark, чтобы привычные сценарии работали
+	{
+		std::string filter;			// --benchmark_filter=S - только замеры, в имени которых есть S
+		std::string outPath;		// --benchmark_out=FILE - итоги в JSON
+		std::string baselinePath;	// --benchmark_baseline=FILE - JSON прошлой сборки для сравнения
+		double minSeconds{ 0.25 };	// --benchmark_min_time=T - минимальное время одного замера
+		double tolerance{ 0.10 };	// --benchmark_tolerance=X - допустимое относительное замедление
+	};
+
+	inline Options parseOptions(int argc, char* argv[])
+	{
+		Options options;
+
+		for (int i = 1; i < argc; ++i)
+		{
+			auto valueOf = [&](const char* key) -> const char*
+			{
+				auto keyLength = std::strlen(key);
+
+				return !std::strncmp(argv[i], key, keyLength) && argv[i][keyLength] == '=' ? argv[i] + keyLength + 1 : nullptr;
+			};
+
+			if (auto value = valueOf("--benchmark_filter")) options.filter = value;
+			else if (auto value = valueOf("--benchmark_out")) options.outPath = value;
+			else if (auto value = valueOf("--benchmark_baseline")) options.baselinePath = value;
+			else if (auto value = valueOf("--benchmark_min_time")) options.minSeconds = std::strtod(value, nullptr);
+			else if (auto value = valueOf("--benchmark_tolerance")) options.tolerance = std::strtod(value, nullptr);
+			else std::cerr << "Unknown option ignored: " << argv[i] << "\n";
+		}
+
+		return options;
+	}
+
+	inline std::string escapeJson(const std::string& text)
+	{
+		std::string escaped;
+
+		for (char c : text)
+		{
+			if (c == '"' || c == '\\') escaped += '\\';
+			escaped += c;
+		}
+
+		return escaped;
+	}
+
+	inline void writeJson(std::ostream& out, const std::string& executable, const std::vector<Result>& results) // раскладка повторяет вывод Google Benchmark
+	{
+		char date[32];
+		auto now = std::time(nullptr);
+
+		std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+		out << "{\n  \"context\": {\n    \"date\": \"" << date << "\",\n    \"executable\": \"" << escapeJson(executable)
+			<< "\",\n    \"num_cpus\": " << std::thread::hardware_concurrency()
+#ifdef NDEBUG
+			<< ",\n    \"library_build_type\": \"release\"\n  },\n"
+#else
+			<< ",\n    \"library_build_type\": \"debug\"\n  },\n"
+#endif
+			<< "  \"benchmarks\": [";
+
+		for (std::size_t i = 0; i < results.size(); ++i)
+		{
+			out << (i ? ",\n" : "\n") << "    {\n      \"name\": \"" << escapeJson(results[i].name) << "\",\n      \"run_type\": \"iteration\",\n      \"iterations\": "
+				<< results[i].iterations << ",\n      \"real_time\": " << std::setprecision(6) << std::fixed << results[i].nsPerIteration
+				<< ",\n      \"time_unit\": \"ns\"\n    }";
+		}
+
+		out << "\n  ]\n}\n";
+	}
+
+	inline std::map<std::string, double> readJsonTimes(std::istream& in) // достаёт пары name/real_time из JSON, записанного writeJson или Google Benchmark
+	{
+		std::map<std::string, double> times;
+		std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+		std::size_t position = 0;
+
+		while ((position = text.find("\"name\"", position)) != std::string::npos)
+		{
+			auto nameStart = text.find('"', text.find(':', position)) + 1;
+			auto nameEnd = nameStart;
+
+			while (nameEnd < text.size() && text[nameEnd] != '"')
+				nameEnd += text[nameEnd] == '\\' ? 2 : 1;
+
+			auto timePosition = text.find("\"real_time\"", nameEnd);
+			auto nextName = text.find("\"name\"", nameEnd);
+
+			if (timePosition == std::string::npos || (nextName != std::string::npos && timePosition > nextName))
+			{
+				position = nameEnd;
+				continue;
+			}
+
+			std::string name;
+
+			for (auto i = nameStart; i < nameEnd; ++i)
+			{
+				if (text[i] == '\\') ++i;
+				name += text[i];
+			}
+
+			times[name] = std::strtod(text.c_str() + text.find(':', timePosition) + 1, nullptr);
+			position = nameEnd;
+		}
+
+		return times;
+	}
+
+	inline std::size_t compare(const std::map<std::string, double>& baseline, const std::vector<Result>& results, double tolerance) // возвращает число замедлившихся замеров
+	{
+		std::size_t regressionCount = 0;
+
+		std::cout << "\n" << std::left << std::setw(48) << "Benchmark" << std::right << std::setw(16) << "baseline ns" << std::setw(16) << "current ns" << std::setw(10) << "delta" << "\n";
+
+		for (const auto& result : results)
+		{
+			auto entry = baseline.find(result.name);
+
+			if (entry == baseline.end() || entry->second <= 0)
+				continue;
+
+			double delta = result.nsPerIteration / entry->second - 1;
+			bool isRegression = delta > tolerance;
+
+			regressionCount += isRegression;
+			std::cout << std::left << std::setw(48) << result.name << std::right << std::fixed << std::setprecision(2) << std::setw(16) << entry->second
+				<< std::setw(16) << result.nsPerIteration << std::setw(9) << delta * 100 << "%" << (isRegression ? "  REGRESSION" : "") << "\n";
+		}
+
+		return regressionCount;
+	}
+
+	inline void print(const std::vector<Result>& results)
+	{
+		std::cout << std::left << std::setw(48) << "Benchmark" << std::right << std::setw(16) << "ns/iter" << std::setw(16) << "iterations" << "\n";
+
+		for (const auto& result : results)
+		{
+			std::cout << std::left << std::setw(48) << result.name << std::right << std::fixed << std::setprecision(2)
+				<< std::setw(16) << result.nsPerIteration << std::setw(16) << result.iterations << "\n";
+		}
+	}
+
+	class Suite // набор замеров одного исполняемого файла: фильтр, печать, JSON и сравнение с прошлой сборкой
+	{
+		public:
+			Suite(int argc, char* argv[]) : _executable(argc ? argv[0] : ""), _options(parseOptions(argc, argv)) {}
+			template <typename Body> void add(const std::string& name, Body&& body)
+			{
+				if (_options.filter.empty() || name.find(_options.filter) != std::string::npos)
+					_results.push_back(run(name, std::forward<Body>(body), _options.minSeconds));
+			}
+			int finish() // печатает итоги, записывает JSON; ненулевой код возврата - есть замедления сверх допуска
+			{
+				print(_results);
+
+				if (!_options.outPath.empty())
+				{
+					std::ofstream out(_options.outPath, std::ios_base::out | std::ios_base::trunc);
+					writeJson(out, _executable, _results);
+				}
+
+				if (_options.baselinePath.empty())
+					return EXIT_SUCCESS;
+
+				std::ifstream in(_options.baselinePath);
+
+				if (!in)
+				{
+					std::cerr << "Cannot open the baseline " << _options.baselinePath << "\n";
+					return EXIT_FAILURE;
+				}
+
+				return compare(readJsonTimes(in), _results, _options.tolerance) ? EXIT_FAILURE : EXIT_SUCCESS;
+			}
+
+		private:
+			std::string _executable;
+			Options _options;
+			std::vector<Result> _results;
+	};
+}
+
+#endif // BENCH_HARNESS_HDR_IG
@@ -0,0 +1,211 @@
+#include "BenchHarness.hpp"
+#include "Simulation/simulation.hpp"
+#include "Simulation/Auxilary/CsvWriter.hpp"
+#include "Simulation/Auxilary/PIDController.hpp"
+#include "Simulation/Auxilary/SegmentedBuffer.hpp"
+#include "Simulation/Batch/LockstepBatch.hpp"
+#include "Simulation/Scenario/World.hpp"
+
+#include <memory>
+
+// замеры того, что выполняется каждый такт перехвата; --benchmark_out=FILE и --benchmark_baseline=FILE позволяют сравнивать сборки
+
+struct MissileBenchAccess
+{
+	static double dragDecelerationRate(Missile& missile, double angleOfAttack) { return missile._calculateDragDecelerationRate(angleOfAttack); }
+};
+
+namespace
+{
+	constexpr double engagementDistance = 20000;
+	constexpr double resetTime = 30; // перехват перезапускается раньше, чем ракета может долететь до цели
+
+	void resetEngagement(Simulation& sim)
+	{
+		sim.restoreSimState();
+		sim.getTarget()->setCoords(0, engagementDistance);
+		sim.getTarget()->setVelocity(0, -200);
+		sim.getMissile()->setCoords(0, 0);
+		sim.getMissile()->setVelocity(0, 200);
+	}
+
+	std::unique_ptr<World> makeSalvo(std::size_t objectCount, bool useBroadphase)
+	{
+		WorldSettings settings;
+		settings.useBroadphase = useBroadphase;
+		auto world = std::make_unique<World>(objectCount, objectCount, settings);
+
+		for (std::size_t i = 0; i < objectCount; ++i)
+		{
+			world->addTarget(200, (i - 0.5 * objectCount) * 50, engagementDistance);
+			world->addMissile(200, (i - 0.5 * objectCount) * 50, 0);
+			world->assignTarget(i, i);
+		}
+
+		world->seed(1);
+
+		return world;
+	}
+
+	void iterateSalvo(std::unique_ptr<World>& world, std::size_t objectCount, bool useBroadphase)
+	{
+		if (world->isFinished() || world->getElapsedTime() > resetTime)
+			world = makeSalvo(objectCount, useBroadphase);
+
+		world->iterate();
+		Bench::doNotOptimize(world->getMissile(0).getCoordinates());
+	}
+
+	void iterateEngagement(Simulation& sim)
+	{
+		if (sim.getElapsedTime() > resetTime)
+			resetEngagement(sim);
+
+		sim.iterate();
+		Bench::doNotOptimize(sim.getMissile()->getCoordinates());
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	Bench::Suite suite(argc, argv);
+	Simulation eulerSim(Vec2d(0, engagementDistance), 200, Vec2d(0, 0), 200, false);
+	Simulation rk45Sim(Vec2d(0, engagementDistance), 200, Vec2d(0, 0), 200, false);
+	IntegrationSettings rk45Settings;
+	Missile leMsl(200, 0, 0);
+	Target leTgt(200, 0, engagementDistance);
+	PIDController pid(SIM_RESOLUTION, -1, 1, 0.8, 0.1, 0.05);
+	Vec2d firstVector(0, 300), secondVector(30, 200), rotatedVector(0, 300);
+	double input = 0;
+
+	eulerSim.seed(1);
+	rk45Sim.seed(1);
+	rk45Settings.method = IntegrationMethod::RK45;
+	rk45Sim.setIntegrationSettings(rk45Settings);
+	resetEngagement(eulerSim);
+	resetEngagement(rk45Sim);
+	leMsl.setTarget(&leTgt);
+	leTgt.reseed(1);
+
+	suite.add("Simulation::iterate/euler", [&] { iterateEngagement(eulerSim); });
+	suite.add("Simulation::iterate/rk45", [&] { iterateEngagement(rk45Sim); });
+
+	// полный перехват со случайным манёвром: по одному и связкой - сравнивать нужно время на один перехват
+	EngagementSetup batchSetup;
+	std::vector<std::uint64_t> batchSeeds(LockstepBatch::chunkSize);
+	std::vector<EngagementResult> batchResults(LockstepBatch::chunkSize);
+
+	for (std::size_t i = 0; i < batchSeeds.size(); ++i)
+		batchSeeds[i] = BatchRunner::deriveSeed(1, i);
+
+	suite.add("BatchRunner::runEngagement", [&]
+	{
+		static std::size_t engagementIndex = 0;
+		Bench::doNotOptimize(BatchRunner::runEngagement(batchSetup, batchSeeds[engagementIndex++ % batchSeeds.size()]).missDistance);
+	});
+	suite.add("LockstepBatch::run/" + std::to_string(LockstepBatch::chunkSize), [&]
+	{
+		LockstepBatch batch(batchSetup);
+		batch.run(batchSeeds.data(), batchResults.data(), batchSeeds.size());
+		Bench::doNotOptimize(batchResults.front().missDistance);
+	});
+
+	for (std::size_t objectCount : { 64, 512 })
+	{
+		for (bool useBroadphase : { true, false })
+		{
+			auto world = std::make_shared<std::unique_ptr<World>>(makeSalvo(objectCount, useBroadphase));
+
+			suite.add("World::iterate/" + std::to_string(objectCount) + "x" + std::to_string(objectCount) + (useBroadphase ? "/grid" : "/all_pairs"),
+				[=] { iterateSalvo(*world, objectCount, useBroadphase); });
+		}
+	}
+
+	// запрос ГСН в налёте из 512 целей, растянутом по фронту на 25 км
+	std::vector<Vec2d> raidPositions, raidVelocities(512, Vec2d(0, -200));
+	std::vector<bool> isRaidAlive(512, true);
+
+	for (std::size_t i = 0; i < 512; ++i)
+		raidPositions.emplace_back((i - 256.) * 50, engagementDistance - 10000 + (i % 8) * 500);
+
+	for (bool useGrid : { true, false })
+	{
+		auto index = std::make_shared<SeekerIndex>();
+		index->rebuild(raidPositions, raidVelocities, isRaidAlive, leMsl.getDesc().seekerRange / 4, useGrid);
+
+		suite.add(std::string("SeekerIndex::forEachInCone/512") + (useGrid ? "/grid" : "/all_targets"), [&, index]
+		{
+			std::size_t visibleCount = 0;
+			index->forEachInCone(Vec2d(0, 0), Vec2d(0, 200), degToRad(leMsl.getDesc().seekerMaxOBA), leMsl.getDesc().seekerRange, [&](const SeekerCandidate&) { visibleCount++; });
+			Bench::doNotOptimize(visibleCount);
+		});
+	}
+
+	suite.add("Missile::advancedMove", [&]
+	{
+		if (leMsl.getY() > engagementDistance / 2)
+		{
+			leMsl.setCoords(0, 0);
+			leMsl.setVelocity(0, 200);
+			leMsl.setTarget(&leTgt);
+			leMsl.restore();
+		}
+
+		leMsl.advancedMove(SIM_RESOLUTION);
+		Bench::doNotOptimize(leMsl.getCoordinates());
+	});
+	suite.add("Missile::_calculateDragDecelerationRate", [&]
+	{
+		input = input < 10 ? input + 0.01 : 0;
+		Bench::doNotOptimize(MissileBenchAccess::dragDecelerationRate(leMsl, input));
+	});
+	suite.add("Target::advancedMove", [&]
+	{
+		leTgt.advancedMove(SIM_RESOLUTION);
+		Bench::doNotOptimize(leTgt.getCoordinates());
+	});
+	suite.add("Target::Target", [&] // создание объекта, включая заведение ГСЧ
+	{
+		Target target(200, 0, engagementDistance);
+		Bench::doNotOptimize(target.getCoordinates());
+	});
+	suite.add("PIDController::calculate", [&]
+	{
+		input = input < 1 ? input + 1e-3 : -1;
+		Bench::doNotOptimize(pid.calculate(0.5, input));
+	});
+	suite.add("getAngleBetweenVectorsRad", [&]
+	{
+		secondVector.setX(secondVector.x() < 100 ? secondVector.x() + 0.1 : -100);
+		Bench::doNotOptimize(getAngleBetweenVectorsRad(firstVector, secondVector));
+	});
+	suite.add("rotateVec", [&] { rotateVec(1e-3, rotatedVector); Bench::doNotOptimize(rotatedVector); });
+	suite.add("convertDoubleToStringWithPrecision", [&]
+	{
+		input = input < 1e5 ? input + 12.345 : 0;
+		Bench::doNotOptimize(convertDoubleToStringWithPrecision(input));
+	});
+
+	// запись точки траектории: после первого заполнения сегменты переиспользуются, как при повторных прогонах в GUI
+	SegmentedBuffer<Vec2d> trajectoryBuffer;
+
+	suite.add("SegmentedBuffer::push_back", [&]
+	{
+		if (trajectoryBuffer.size() == 1 << 16)
+			trajectoryBuffer.clear();
+
+		trajectoryBuffer.push_back(rotatedVector);
+	});
+
+	// поток без буфера отбрасывает запись - замеряется только форматирование
+	std::ostream discardStream(nullptr);
+	CsvWriter csv(discardStream);
+
+	suite.add("CsvWriter::writeField", [&]
+	{
+		input = input < 1e5 ? input + 12.345 : 0;
+		csv.writeField(input, STANDARD_PRECISION);
+	});
+
+	return suite.finish();
+}
@@ -0,0 +1,110 @@
+#include "BenchHarness.hpp"
+#include "Simulation/Auxilary/utils.hpp"
+#include "Simulation/Auxilary/VectorRotation.hpp"
+#include "Simulation/SimObjects/KinematicStatePool.hpp"
+
+#include <QTransform>
+#include <QVector2D>
+#include <cmath>
+#include <vector>
+
+// сравнивает прежний поворот через QTransform с поворотом по синусу и косинусу и с пакетным SIMD-поворотом
+
+namespace
+{
+	constexpr std::size_t batchSize = 1024;
+	constexpr double degreesPerStep = 0.5;
+
+	void legacyRotateVec(double angle, QVector2D& vector, const bool isRad = true) // прежняя реализация rotateVec
+	{
+		QTransform transform = isRad ? QTransform().rotateRadians(angle) : QTransform().rotate(angle);
+		QPointF rotatedPoint = transform.map(vector.toPointF());
+
+		vector.setX(rotatedPoint.x());
+		vector.setY(rotatedPoint.y());
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	Bench::Suite suite(argc, argv);
+	QVector2D legacyVector(0, 300);
+	QVector2D legacyActingVectors[2]{ QVector2D(0, 300), QVector2D(1, 0) };
+	Vec2d vector(0, 300);
+	Vec2d actingVectors[2]{ Vec2d(0, 300), Vec2d(1, 0) };
+	double angle = 1e-3;
+	std::vector<double> angles(batchSize), xs(batchSize, 300), ys(batchSize, 0), secondXs(batchSize, 0), secondYs(batchSize, 1);
+	std::vector<QVector2D> legacyVectors(batchSize, QVector2D(300, 0));
+	std::vector<Vec2d> vectors(batchSize, Vec2d(300, 0));
+	KinematicStatePool pool;
+
+	for (std::size_t i = 0; i < batchSize; ++i)
+	{
+		angles[i] = 1e-3 * (double(i) / batchSize - 0.5);
+		pool.add(0, double(i), 0, 300, 1, 0);
+	}
+
+	// один вектор и действующие векторы объекта - то, что делается каждый такт
+	suite.add("rotateVec/legacy_qtransform", [&] { legacyRotateVec(angle, legacyVector); Bench::doNotOptimize(legacyVector); });
+	suite.add("rotateVec/sincos", [&] { rotateVec(angle, vector); Bench::doNotOptimize(vector); });
+	suite.add("acting_vectors/legacy_qtransform", [&]
+	{
+		for (auto& actingVector : legacyActingVectors)
+			legacyRotateVec(angle, actingVector);
+
+		Bench::doNotOptimize(legacyActingVectors[0]);
+	});
+	suite.add("acting_vectors/rotateVecs", [&] { rotateVecs(angle, actingVectors, 2); Bench::doNotOptimize(actingVectors[0]); });
+
+	// множество объектов, каждый на свой угол
+	suite.add("batch_1024/legacy_qtransform", [&]
+	{
+		for (std::size_t i = 0; i < batchSize; ++i)
+			legacyRotateVec(angles[i], legacyVectors[i]);
+
+		Bench::doNotOptimize(legacyVectors.front());
+	});
+	suite.add("batch_1024/scalar_sincos", [&]
+	{
+		for (std::size_t i = 0; i < batchSize; ++i)
+			rotateVec(angles[i], vectors[i]);
+
+		Bench::doNotOptimize(vectors.front());
+	});
+	suite.add("batch_1024/rotateVectorsBatch", [&] { rotateVectorsBatch(angles.data(), xs.data(), ys.data(), batchSize); Bench::doNotOptimize(xs.front()); });
+	suite.add("batch_1024/rotateVectorsBatch_two_sets", [&]
+	{
+		rotateVectorsBatch(angles.data(), xs.data(), ys.data(), secondXs.data(), secondYs.data(), batchSize);
+		Bench::doNotOptimize(xs.front());
+	});
+	suite.add("batch_1024/KinematicStatePool::rotate", [&] { pool.rotate(angles.data()); Bench::doNotOptimize(pool.data<KinematicStatePool::VelXColumn>()[0]); });
+
+	// окружность зоны поражения, как в MainWindow::prepareHitRadData
+	suite.add("hit_radius_contour/legacy_incremental", [&]
+	{
+		QVector2D radVector{ 15.f, 0.f };
+		std::vector<double> radX, radY;
+
+		for (double currentAngle = 0; currentAngle <= 360; currentAngle += degreesPerStep)
+		{
+			legacyRotateVec(degreesPerStep, radVector, false);
+			radX.push_back(radVector.x());
+			radY.push_back(radVector.y());
+		}
+
+		Bench::doNotOptimize(radX.back());
+	});
+	suite.add("hit_radius_contour/rotateVectorsBatch", [&]
+	{
+		const int pointCount = int(360 / degreesPerStep) + 1;
+		std::vector<double> contourAngles(pointCount), radX(pointCount, 15.), radY(pointCount, 0.);
+
+		for (int i = 0; i < pointCount; ++i)
+			contourAngles[i] = degToRad(i * degreesPerStep);
+
+		rotateVectorsBatch(contourAngles.data(), radX.data(), radY.data(), pointCount);
+		Bench::doNotOptimize(radX.back());
+	});
+
+	return suite.finish();
+}
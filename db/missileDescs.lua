@@ -9,8 +9,11 @@ AAMDescs = {
 		DyPerDa				= 1.5,	-- amount of Fy generated per ° of AoA
 		proxyFuzeRadius		= 15,	-- proxy fuze's trigger radius
 		seekerMaxOBA		= 15,	-- seeker's one-side FoV
+		seekerRange			= 15000,	-- seeker's acquisition range
 		navConstant			= 1.5,	-- AP's guidance/navigation constant
-		-- .5M, .9M, 1.2M, 1.5M, 2M, 3M, 4M (7 values in total)
+		apDelay				= 0.5,	-- AP's engagement delay after launch
+		-- Cx0 at the Mach numbers listed in cXMach; without cXMach: .5M, .9M, 1.2M, 1.5M, 2M, 3M, 4M
+		cXMach = { 0.5, 0.9, 1.2, 1.5, 2.0, 3.0, 4.0 };
 		cXData = { 0.012, 0.015, 0.046, 0.044, 0.038, 0.030, 0.026 };
 	},
 }
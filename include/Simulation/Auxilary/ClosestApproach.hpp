@@ -0,0 +1,16 @@
+#ifndef CLOSEST_APPROACH_HDR_IG
+#define CLOSEST_APPROACH_HDR_IG
+
+struct ClosestApproach // точка наибольшего сближения на отрезке относительного движения
+{
+	double fraction{ 0 };	// доля шага (0..1), на которую приходится наибольшее сближение
+	double distance{ 0 };	// расстояние в этой точке
+};
+
+// наибольшее сближение при линейном относительном движении из (startX, startY) в (endX, endY) за шаг
+ClosestApproach findClosestApproach(double startX, double startY, double endX, double endY);
+
+// доля шага, на которой расстояние впервые становится не больше radius; отрицательное значение - сфера не пересекается
+double findSphereEntryFraction(double startX, double startY, double endX, double endY, double radius);
+
+#endif // CLOSEST_APPROACH_HDR_IG
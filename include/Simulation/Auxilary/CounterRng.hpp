@@ -0,0 +1,36 @@
+#ifndef COUNTER_RNG_HDR_IG
+#define COUNTER_RNG_HDR_IG
+
+#include <cstdint>
+
+class CounterRng // ГСЧ на счётчике: n-й отсчёт - хэш пары (ключ потока, n), всё состояние - 16 байт
+{
+	public:
+		constexpr explicit CounterRng(std::uint64_t key = 0) : _key(key) {}
+		static constexpr std::uint64_t mix(std::uint64_t z) // финализатор SplitMix64
+		{
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+
+			return z ^ (z >> 31);
+		}
+		static constexpr std::uint64_t deriveKey(std::uint64_t masterSeed, std::uint64_t streamIndex) // ключ потока по общему зерну - соседние номера дают некоррелированные ключи
+		{
+			return mix(masterSeed + (streamIndex + 1) * _goldenGamma);
+		}
+		constexpr std::uint64_t at(std::uint64_t index) const { return mix(_key ^ mix((index + 1) * _goldenGamma)); } // отсчёт с номером index - без прохода по предыдущим
+		std::uint64_t next() { return at(_counter++); }
+		double nextDouble() { return (next() >> 11) * 0x1.0p-53; } // равномерно на [0; 1)
+		double nextInRange(double minValue, double maxValue) { return minValue + (maxValue - minValue) * nextDouble(); }
+		void seed(std::uint64_t key) { _key = key; _counter = 0; }
+		std::uint64_t getKey() const { return _key; }
+		std::uint64_t getCounter() const { return _counter; }
+		void setCounter(std::uint64_t counter) { _counter = counter; } // переход к любому отсчёту за O(1)
+
+	private:
+		static constexpr std::uint64_t _goldenGamma = 0x9E3779B97F4A7C15ull;
+		std::uint64_t _key;
+		std::uint64_t _counter{ 0 };
+};
+
+#endif // COUNTER_RNG_HDR_IG
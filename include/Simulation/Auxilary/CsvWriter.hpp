@@ -0,0 +1,48 @@
+#ifndef CSV_WRITER_HDR_IG
+#define CSV_WRITER_HDR_IG
+
+#include <charconv>
+#include <cstddef>
+#include <ostream>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#define CSV_FIELD_SEPARATOR ';'
+
+// пишет число в фиксированном формате в [first, last) без выделения памяти и локалей; разделитель дробной части заменяется на месте
+// возвращает конец записанного; при нехватке места - first
+char* formatFixed(char* first, char* last, double value, int precision, char decimalSeparator = ',');
+
+class CsvWriter // поля копятся в одном буфере и уходят в поток крупными кусками; каждое поле завершается ';', как в прежнем выводе
+{
+	public:
+		explicit CsvWriter(std::ostream& output, char decimalSeparator = ',', std::size_t bufferSize = 1 << 16);
+		CsvWriter(const CsvWriter&) = delete;
+		CsvWriter& operator=(const CsvWriter&) = delete;
+		~CsvWriter() { flush(); }
+
+		void writeField(double value, int precision);
+		template <typename T> std::enable_if_t<std::is_integral_v<T>> writeField(T value)
+		{
+			auto first = _reserve(maxIntegerLength + 1);
+			auto last = std::to_chars(first, first + maxIntegerLength, value).ptr;
+
+			*last++ = CSV_FIELD_SEPARATOR;
+			_size = last - _buffer.data();
+		}
+		void writeField(std::string_view text);
+		void endRecord() { *_reserve(1) = '\n'; _size++; }
+		void flush(); // отдаёт накопленное в поток
+
+	private:
+		static constexpr std::size_t maxIntegerLength{ 24 };
+		static constexpr std::size_t maxIntegralDigits{ 310 };	// целая часть наибольшего double в фиксированном формате
+		std::ostream& _output;
+		char _decimalSeparator;
+		std::vector<char> _buffer;
+		std::size_t _size{ 0 };
+		char* _reserve(std::size_t count); // указатель на свободное место не меньше count символов; при нехватке буфер сбрасывается в поток
+};
+
+#endif // CSV_WRITER_HDR_IG
@@ -0,0 +1,112 @@
+#ifndef INTEGRATORS_HDR_IG
+#define INTEGRATORS_HDR_IG
+
+#include "Simulation/CommonSimParams.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+enum class IntegrationMethod
+{
+	Euler,	// явный метод Эйлера с шагом SIM_RESOLUTION - прежнее поведение
+	RK4,	// классический Рунге-Кутта 4-го порядка с постоянным шагом
+	RK45	// вложенный метод Дормана-Принса 5(4) с управлением шагом
+};
+
+struct IntegrationSettings // выбор метода интегрирования и параметры управления шагом
+{
+	IntegrationMethod method	= IntegrationMethod::Euler;
+	double fixedStep			= SIM_RESOLUTION;	// шаг RK4 и начальный шаг RK45 (метод Эйлера всегда идёт с шагом SIM_RESOLUTION)
+	double tolerance			= 1e-6;				// допустимая относительная (и абсолютная) локальная ошибка RK45
+	double minStep				= 1e-4;				// пределы шага RK45
+	double maxStep				= 1.;
+};
+
+namespace Integrators // шаги явных методов Рунге-Кутты для систем вида dy/dt = f(t, y) с фиксированной размерностью
+{
+	template <std::size_t N> using Vector = std::array<double, N>;
+
+	template <std::size_t N> Vector<N> addScaled(const Vector<N>& base, double scale, const Vector<N>& direction)
+	{
+		Vector<N> result;
+
+		for (std::size_t i = 0; i < N; ++i)
+			result[i] = base[i] + scale * direction[i];
+
+		return result;
+	}
+
+	template <std::size_t N, typename Derivative> Vector<N> rk4Step(Derivative&& f, double t, const Vector<N>& y, double h)
+	{
+		auto k1 = f(t, y);
+		auto k2 = f(t + h / 2, addScaled(y, h / 2, k1));
+		auto k3 = f(t + h / 2, addScaled(y, h / 2, k2));
+		auto k4 = f(t + h, addScaled(y, h, k3));
+		Vector<N> result;
+
+		for (std::size_t i = 0; i < N; ++i)
+			result[i] = y[i] + h / 6 * (k1[i] + 2 * k2[i] + 2 * k3[i] + k4[i]);
+
+		return result;
+	}
+
+	// шаг Дормана-Принса: возвращает решение 5-го порядка, в error - разность с решением 4-го порядка
+	template <std::size_t N, typename Derivative> Vector<N> dormandPrinceStep(Derivative&& f, double t, const Vector<N>& y, double h, Vector<N>& error)
+	{
+		constexpr double a21 = 1. / 5;
+		constexpr double a31 = 3. / 40, a32 = 9. / 40;
+		constexpr double a41 = 44. / 45, a42 = -56. / 15, a43 = 32. / 9;
+		constexpr double a51 = 19372. / 6561, a52 = -25360. / 2187, a53 = 64448. / 6561, a54 = -212. / 729;
+		constexpr double a61 = 9017. / 3168, a62 = -355. / 33, a63 = 46732. / 5247, a64 = 49. / 176, a65 = -5103. / 18656;
+		constexpr double b1 = 35. / 384, b3 = 500. / 1113, b4 = 125. / 192, b5 = -2187. / 6784, b6 = 11. / 84;
+		constexpr double e1 = b1 - 5179. / 57600, e3 = b3 - 7571. / 16695, e4 = b4 - 393. / 640, e5 = b5 + 92097. / 339200, e6 = b6 - 187. / 2100, e7 = -1. / 40;
+		Vector<N> stage, result;
+
+		auto k1 = f(t, y);
+
+		for (std::size_t i = 0; i < N; ++i) stage[i] = y[i] + h * a21 * k1[i];
+		auto k2 = f(t + h / 5, stage);
+
+		for (std::size_t i = 0; i < N; ++i) stage[i] = y[i] + h * (a31 * k1[i] + a32 * k2[i]);
+		auto k3 = f(t + 3 * h / 10, stage);
+
+		for (std::size_t i = 0; i < N; ++i) stage[i] = y[i] + h * (a41 * k1[i] + a42 * k2[i] + a43 * k3[i]);
+		auto k4 = f(t + 4 * h / 5, stage);
+
+		for (std::size_t i = 0; i < N; ++i) stage[i] = y[i] + h * (a51 * k1[i] + a52 * k2[i] + a53 * k3[i] + a54 * k4[i]);
+		auto k5 = f(t + 8 * h / 9, stage);
+
+		for (std::size_t i = 0; i < N; ++i) stage[i] = y[i] + h * (a61 * k1[i] + a62 * k2[i] + a63 * k3[i] + a64 * k4[i] + a65 * k5[i]);
+		auto k6 = f(t + h, stage);
+
+		for (std::size_t i = 0; i < N; ++i) result[i] = y[i] + h * (b1 * k1[i] + b3 * k3[i] + b4 * k4[i] + b5 * k5[i] + b6 * k6[i]);
+		auto k7 = f(t + h, result);
+
+		for (std::size_t i = 0; i < N; ++i)
+			error[i] = h * (e1 * k1[i] + e3 * k3[i] + e4 * k4[i] + e5 * k5[i] + e6 * k6[i] + e7 * k7[i]);
+
+		return result;
+	}
+
+	// взвешенная максимум-норма ошибки: 1 - ошибка на границе допуска
+	template <std::size_t N> double errorNorm(const Vector<N>& error, const Vector<N>& y, const Vector<N>& yNew, const Vector<N>& absTolerance, double relTolerance)
+	{
+		double norm = 0;
+
+		for (std::size_t i = 0; i < N; ++i)
+			norm = std::max(norm, std::abs(error[i]) / (absTolerance[i] + relTolerance * std::max(std::abs(y[i]), std::abs(yNew[i]))));
+
+		return norm;
+	}
+
+	inline double nextStepFactor(double errorNorm) // множитель следующего шага по норме ошибки (показатель 1/5 для пары 5(4))
+	{
+		constexpr double safety = 0.9, minFactor = 0.2, maxFactor = 5.;
+
+		return errorNorm > 0 ? std::clamp(safety * std::pow(errorNorm, -0.2), minFactor, maxFactor) : maxFactor;
+	}
+}
+
+#endif // INTEGRATORS_HDR_IG
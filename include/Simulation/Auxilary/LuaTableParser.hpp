@@ -0,0 +1,42 @@
+#ifndef LUA_TABLE_PARSER_HDR_IG
+#define LUA_TABLE_PARSER_HDR_IG
+
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+struct LuaTable;
+
+struct LuaValue // значение Lua: nil, логическое, число, строка или таблица
+{
+	enum class Type { Nil, Boolean, Number, String, Table };
+	Type type{ Type::Nil };
+	bool boolean{ false };
+	double number{ 0 };
+	std::string string;
+	std::shared_ptr<const LuaTable> table;
+};
+
+struct LuaTable // таблица Lua - именованные поля и позиционные элементы хранятся раздельно
+{
+	std::map<std::string, LuaValue> fields;
+	std::vector<LuaValue> items;
+
+	const LuaTable* getTable(const std::string& key) const;
+	double getNumber(const std::string& key, double fallback) const;
+	std::vector<double> getNumbers(const std::string& key) const; // позиционные числа вложенной таблицы key
+};
+
+class LuaParseError : public std::runtime_error
+{
+	public:
+		LuaParseError(const std::string& message, int line) : std::runtime_error("line " + std::to_string(line) + ": " + message) {}
+};
+
+// разбирает файл описаний, состоящий из присваиваний глобальным переменным литералов-таблиц (db/*.lua); код Lua не исполняется
+LuaTable parseLuaAssignments(const std::string& source);
+LuaTable parseLuaAssignmentsFile(const std::string& filePath);
+
+#endif // LUA_TABLE_PARSER_HDR_IG
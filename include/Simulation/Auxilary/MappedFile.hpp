@@ -0,0 +1,28 @@
+#ifndef MAPPED_FILE_HDR_IG
+#define MAPPED_FILE_HDR_IG
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class MappedFile // файл, отображённый в память только для чтения: страницы подгружаются системой по мере обращения
+{
+	public:
+		explicit MappedFile(const std::string& filePath); // при ошибке открытия или отображения - std::runtime_error
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+		~MappedFile();
+		const std::uint8_t* getData() const { return _data; }
+		std::size_t getSize() const { return _size; }
+		void prefetch(std::size_t offset, std::size_t size) const; // подсказка системе заранее подгрузить диапазон
+
+	private:
+		const std::uint8_t* _data{ nullptr };
+		std::size_t _size{ 0 };
+#ifdef _WIN32
+		void* _fileHandle{ nullptr };
+		void* _mappingHandle{ nullptr };
+#endif
+};
+
+#endif // MAPPED_FILE_HDR_IG
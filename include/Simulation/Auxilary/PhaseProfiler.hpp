@@ -0,0 +1,149 @@
+#ifndef PHASE_PROFILER_HDR_IG
+#define PHASE_PROFILER_HDR_IG
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cmath>
+#include <cstdint>
+#include <ostream>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define MGE_PROFILER_HAS_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define MGE_PROFILER_HAS_TSC 1
+#else
+#include <chrono>
+#endif
+
+// замер фаз такта: включается опцией MGE_ENABLE_PROFILER (определение MGE_PROFILER), без неё макрос ничего не порождает
+#ifdef MGE_PROFILER
+#define MGE_PROFILE_CONCAT_IMPL(a, b) a##b
+#define MGE_PROFILE_CONCAT(a, b) MGE_PROFILE_CONCAT_IMPL(a, b)
+#define MGE_PROFILE_SCOPE(phase) PhaseProfiler::ScopedTimer MGE_PROFILE_CONCAT(profileScope, __LINE__)(PhaseProfiler::Phase::phase)
+#else
+#define MGE_PROFILE_SCOPE(phase) ((void)0)
+#endif
+
+namespace PhaseProfiler // счётчики и гистограммы длительностей по фазам; каждый поток пишет в свои счётчики без блокировок
+{
+	enum class Phase : std::size_t
+	{
+		SimulationTick,			// Simulation::iterate целиком
+		MissileGuidance,		// Missile::advancedMove - наведение и движение ракеты, включая сопротивление
+		MissileDrag,			// Missile::_calculateDragDecelerationRate
+		TargetManeuver,			// Target::advancedMove
+		TrajectoryAppend,		// передача записи траектории в буфер записи
+		TrajectoryBlockWrite,	// сжатие и запись блока в фоновом потоке
+		CsvExport,				// перекладка записи траектории в CSV
+		Count
+	};
+
+	// каждая октава [2^k, 2^(k+1)) тактов счётчика делится на 4 равные корзины - относительная погрешность квантилей не больше 25%
+	constexpr std::size_t histogramSubBuckets = 4;
+	constexpr std::size_t histogramBucketCount = 160;
+
+	struct PhaseStats // сводка по фазе для отчёта
+	{
+		std::uint64_t count{ 0 };
+		std::uint64_t totalTicks{ 0 };
+		std::uint64_t minTicks{ ~std::uint64_t(0) };
+		std::uint64_t maxTicks{ 0 };
+		std::array<std::uint64_t, histogramBucketCount> histogram{};
+	};
+
+	// счётчики фазы в потоке: меняет только поток-владелец, отчёт читает их во время записи - поэтому атомарные, но без read-modify-write
+	struct PhaseCounters
+	{
+		std::atomic<std::uint64_t> count{ 0 };
+		std::atomic<std::uint64_t> totalTicks{ 0 };
+		std::atomic<std::uint64_t> minTicks{ ~std::uint64_t(0) };
+		std::atomic<std::uint64_t> maxTicks{ 0 };
+		std::array<std::atomic<std::uint64_t>, histogramBucketCount> histogram{};
+	};
+
+	struct ThreadStats
+	{
+		std::atomic<std::uint64_t> epoch{ 0 };	// номер сброса, после которого начаты счётчики
+		std::array<PhaseCounters, std::size_t(Phase::Count)> phases;
+	};
+
+	// reset() только увеличивает номер, счётчики обнуляет сам поток-владелец при следующем замере - сброс не пишет в чужие счётчики
+	inline std::atomic<std::uint64_t> resetEpoch{ 0 };
+
+	inline void storeOwned(std::atomic<std::uint64_t>& counter, std::uint64_t value) { counter.store(value, std::memory_order_relaxed); }
+	inline std::uint64_t loadOwned(const std::atomic<std::uint64_t>& counter) { return counter.load(std::memory_order_relaxed); }
+
+	inline std::uint64_t readTicks()
+	{
+#ifdef MGE_PROFILER_HAS_TSC
+		return __rdtsc();
+#else
+		return std::uint64_t(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+	}
+
+	inline std::size_t getHistogramBucket(std::uint64_t ticks) // октава по старшему единичному биту, корзина в ней - по двум следующим
+	{
+		if (ticks < histogramSubBuckets)
+			return std::size_t(ticks);
+
+#ifdef _MSC_VER
+		unsigned long octave;
+		_BitScanReverse64(&octave, ticks);
+#else
+		std::size_t octave = 63 - __builtin_clzll(ticks);
+#endif
+		return std::min<std::size_t>((octave - 1) * histogramSubBuckets + ((ticks >> (octave - 2)) & (histogramSubBuckets - 1)), histogramBucketCount - 1);
+	}
+
+	inline double getHistogramBucketStart(std::size_t bucket) // нижняя граница корзины в тактах счётчика
+	{
+		if (bucket < histogramSubBuckets)
+			return double(bucket);
+
+		return std::ldexp(double(histogramSubBuckets + bucket % histogramSubBuckets), int(bucket / histogramSubBuckets) - 1);
+	}
+
+	ThreadStats* getThreadStats();				// счётчики текущего потока, заводятся при первом обращении и живут до конца программы
+	void startEpoch(ThreadStats& threadStats, std::uint64_t epoch);	// обнуляет счётчики потока-владельца после сброса
+
+	inline void record(Phase phase, std::uint64_t ticks)
+	{
+		thread_local ThreadStats* threadStats = getThreadStats();
+		const auto epoch = resetEpoch.load(std::memory_order_relaxed);
+
+		if (loadOwned(threadStats->epoch) != epoch)
+			startEpoch(*threadStats, epoch);
+
+		auto& stats = threadStats->phases[std::size_t(phase)];
+		auto& bucket = stats.histogram[getHistogramBucket(ticks)];
+
+		storeOwned(stats.count, loadOwned(stats.count) + 1);
+		storeOwned(stats.totalTicks, loadOwned(stats.totalTicks) + ticks);
+		storeOwned(stats.minTicks, std::min(loadOwned(stats.minTicks), ticks));
+		storeOwned(stats.maxTicks, std::max(loadOwned(stats.maxTicks), ticks));
+		storeOwned(bucket, loadOwned(bucket) + 1);
+	}
+
+	void reset();					// можно вызывать во время замеров: замеры до сброса в отчёт больше не попадают
+	void report(std::ostream& output);	// сводка по всем потокам: число вызовов, время, квантили по гистограмме
+
+	class ScopedTimer
+	{
+		public:
+			explicit ScopedTimer(Phase phase) : _phase(phase), _startTicks(readTicks()) {}
+			ScopedTimer(const ScopedTimer&) = delete;
+			ScopedTimer& operator=(const ScopedTimer&) = delete;
+			~ScopedTimer() { record(_phase, readTicks() - _startTicks); }
+
+		private:
+			Phase _phase;
+			std::uint64_t _startTicks;
+	};
+}
+
+#endif // PHASE_PROFILER_HDR_IG
@@ -0,0 +1,79 @@
+#ifndef SEGMENTED_BUFFER_HDR_IG
+#define SEGMENTED_BUFFER_HDR_IG
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// буфер из сегментов постоянной ёмкости: при росте добавляется новый сегмент, уже записанные элементы не копируются и не перемещаются
+template <typename T, std::size_t SegmentCapacity = 4096> class SegmentedBuffer
+{
+	static_assert(SegmentCapacity && !(SegmentCapacity & (SegmentCapacity - 1)), "segment capacity must be a power of two");
+
+	public:
+		struct Stats // для оценки того, насколько верно был задан запас
+		{
+			std::size_t size{ 0 };
+			std::size_t capacity{ 0 };
+			std::size_t reservedSegments{ 0 };	// сегменты, выделенные заранее по оценке
+			std::size_t grownSegments{ 0 };		// сегменты, выделенные при записи сверх оценки
+		};
+
+		void reserve(std::size_t capacity) // выделяет сегменты заранее, чтобы при записи не обращаться к куче
+		{
+			while (_segments.size() * SegmentCapacity < capacity)
+			{
+				_segments.push_back(std::make_unique<T[]>(SegmentCapacity));
+				_reservedSegments++;
+			}
+		}
+
+		void push_back(const T& value)
+		{
+			if (_size == _segments.size() * SegmentCapacity)
+			{
+				_segments.push_back(std::make_unique<T[]>(SegmentCapacity));
+				_grownSegments++;
+			}
+
+			_segments[_size / SegmentCapacity][_size % SegmentCapacity] = value;
+			_size++;
+		}
+
+		void clear() // сегменты остаются выделенными для следующей записи
+		{
+			_size = 0;
+			_reservedSegments = _segments.size();
+			_grownSegments = 0;
+		}
+
+		std::size_t size() const { return _size; }
+		bool empty() const { return !_size; }
+		const T& operator[](std::size_t index) const { return _segments[index / SegmentCapacity][index % SegmentCapacity]; }
+		T& operator[](std::size_t index) { return _segments[index / SegmentCapacity][index % SegmentCapacity]; }
+		const T& back() const { return (*this)[_size - 1]; }
+
+		// visitor(const T* data, std::size_t count) вызывается для непрерывных кусков [first, last) - для пакетного копирования
+		template <typename Visitor> void forEachChunk(std::size_t first, std::size_t last, Visitor&& visitor) const
+		{
+			while (first < last)
+			{
+				auto offset = first % SegmentCapacity;
+				auto count = std::min(SegmentCapacity - offset, last - first);
+
+				visitor(_segments[first / SegmentCapacity].get() + offset, count);
+				first += count;
+			}
+		}
+
+		Stats getStats() const { return { _size, _segments.size() * SegmentCapacity, _reservedSegments, _grownSegments }; }
+
+	private:
+		std::vector<std::unique_ptr<T[]>> _segments;
+		std::size_t _size{ 0 };
+		std::size_t _reservedSegments{ 0 };
+		std::size_t _grownSegments{ 0 };
+};
+
+#endif // SEGMENTED_BUFFER_HDR_IG
@@ -0,0 +1,230 @@
+#ifndef SIMD_MATH_HDR_IG
+#define SIMD_MATH_HDR_IG
+
+#include <cmath>
+#include <cstddef>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace SimdMath // полосы SIMD и функции, одинаково считаемые в каждой полосе, - общие для пакетных расчётов ядра
+{
+	struct ScalarLanes // одна полоса - обрабатывает хвосты и платформы без SIMD
+	{
+		using Pack = double;
+		using Mask = bool;
+		static constexpr std::size_t width = 1;
+
+		static Pack load(const double* source) { return *source; }
+		static void store(double* destination, Pack value) { *destination = value; }
+		static Pack set(double value) { return value; }
+		static Pack add(Pack a, Pack b) { return a + b; }
+		static Pack sub(Pack a, Pack b) { return a - b; }
+		static Pack mul(Pack a, Pack b) { return a * b; }
+		static Pack div(Pack a, Pack b) { return a / b; }
+		static Pack sqrt(Pack a) { return std::sqrt(a); }
+		static Pack min(Pack a, Pack b) { return b < a ? b : a; }
+		static Pack max(Pack a, Pack b) { return a < b ? b : a; }
+		static Pack abs(Pack a) { return std::abs(a); }
+		static Pack floor(Pack a) { return std::floor(a); }
+		static Mask equal(Pack a, Pack b) { return a == b; }
+		static Mask less(Pack a, Pack b) { return a < b; }
+		static Mask lessEqual(Pack a, Pack b) { return a <= b; }
+		static Mask both(Mask a, Mask b) { return a && b; }
+		static Mask either(Mask a, Mask b) { return a || b; }
+		static Mask andNot(Mask a, Mask b) { return a && !b; }	// a и не b
+		static int bits(Mask mask) { return mask; }				// по биту на полосу
+		static Pack gather(const double* base, Pack indices) { return base[static_cast<std::size_t>(indices)]; } // base[indices[i]] по полосам, индексы - целые неотрицательные
+		static Pack select(Mask mask, Pack ifTrue, Pack ifFalse) { return mask ? ifTrue : ifFalse; }
+	};
+
+#if defined(__AVX__)
+	struct SimdLanes // четыре полосы AVX
+	{
+		using Pack = __m256d;
+		using Mask = __m256d;
+		static constexpr std::size_t width = 4;
+
+		static Pack load(const double* source) { return _mm256_loadu_pd(source); }
+		static void store(double* destination, Pack value) { _mm256_storeu_pd(destination, value); }
+		static Pack set(double value) { return _mm256_set1_pd(value); }
+		static Pack add(Pack a, Pack b) { return _mm256_add_pd(a, b); }
+		static Pack sub(Pack a, Pack b) { return _mm256_sub_pd(a, b); }
+		static Pack mul(Pack a, Pack b) { return _mm256_mul_pd(a, b); }
+		static Pack div(Pack a, Pack b) { return _mm256_div_pd(a, b); }
+		static Pack sqrt(Pack a) { return _mm256_sqrt_pd(a); }
+		static Pack min(Pack a, Pack b) { return _mm256_min_pd(a, b); }
+		static Pack max(Pack a, Pack b) { return _mm256_max_pd(a, b); }
+		static Pack abs(Pack a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.), a); }
+		static Pack floor(Pack a) { return _mm256_floor_pd(a); }
+		static Mask equal(Pack a, Pack b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+		static Mask less(Pack a, Pack b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+		static Mask lessEqual(Pack a, Pack b) { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); }
+		static Mask both(Mask a, Mask b) { return _mm256_and_pd(a, b); }
+		static Mask either(Mask a, Mask b) { return _mm256_or_pd(a, b); }
+		static Mask andNot(Mask a, Mask b) { return _mm256_andnot_pd(b, a); }
+		static int bits(Mask mask) { return _mm256_movemask_pd(mask); }
+#if defined(__AVX2__)
+		// форма с маской: у простой формы исходный регистр не инициализирован, и GCC предупреждает об этом
+		static Pack gather(const double* base, Pack indices) { return _mm256_mask_i32gather_pd(_mm256_setzero_pd(), base, _mm256_cvttpd_epi32(indices), _mm256_castsi256_pd(_mm256_set1_epi64x(-1)), 8); }
+#else
+		static Pack gather(const double* base, Pack indices)
+		{
+			alignas(32) double lanes[width];
+
+			_mm256_store_pd(lanes, indices);
+
+			return _mm256_setr_pd(base[std::size_t(lanes[0])], base[std::size_t(lanes[1])], base[std::size_t(lanes[2])], base[std::size_t(lanes[3])]);
+		}
+#endif
+		static Pack select(Mask mask, Pack ifTrue, Pack ifFalse) { return _mm256_blendv_pd(ifFalse, ifTrue, mask); }
+	};
+#elif defined(__SSE2__) || defined(_M_X64)
+	struct SimdLanes // две полосы SSE2 - есть на любом x86-64
+	{
+		using Pack = __m128d;
+		using Mask = __m128d;
+		static constexpr std::size_t width = 2;
+
+		static Pack load(const double* source) { return _mm_loadu_pd(source); }
+		static void store(double* destination, Pack value) { _mm_storeu_pd(destination, value); }
+		static Pack set(double value) { return _mm_set1_pd(value); }
+		static Pack add(Pack a, Pack b) { return _mm_add_pd(a, b); }
+		static Pack sub(Pack a, Pack b) { return _mm_sub_pd(a, b); }
+		static Pack mul(Pack a, Pack b) { return _mm_mul_pd(a, b); }
+		static Pack div(Pack a, Pack b) { return _mm_div_pd(a, b); }
+		static Pack sqrt(Pack a) { return _mm_sqrt_pd(a); }
+		static Pack min(Pack a, Pack b) { return _mm_min_pd(a, b); }
+		static Pack max(Pack a, Pack b) { return _mm_max_pd(a, b); }
+		static Pack abs(Pack a) { return _mm_andnot_pd(_mm_set1_pd(-0.), a); }
+		static Pack floor(Pack a) // в SSE2 нет floor: округление прибавлением 2^52, затем поправка вниз; большие по модулю значения уже целые
+		{
+			const auto magic = _mm_set1_pd(4503599627370496.);
+			const auto sign = _mm_and_pd(a, _mm_set1_pd(-0.));
+			const auto absolute = abs(a);
+			const auto rounded = _mm_or_pd(_mm_sub_pd(_mm_add_pd(absolute, magic), magic), sign);
+			const auto floored = _mm_sub_pd(rounded, _mm_and_pd(_mm_cmpgt_pd(rounded, a), _mm_set1_pd(1.)));
+
+			return select(_mm_cmplt_pd(absolute, magic), floored, a);
+		}
+		static Mask equal(Pack a, Pack b) { return _mm_cmpeq_pd(a, b); }
+		static Mask less(Pack a, Pack b) { return _mm_cmplt_pd(a, b); }
+		static Mask lessEqual(Pack a, Pack b) { return _mm_cmple_pd(a, b); }
+		static Mask both(Mask a, Mask b) { return _mm_and_pd(a, b); }
+		static Mask either(Mask a, Mask b) { return _mm_or_pd(a, b); }
+		static Mask andNot(Mask a, Mask b) { return _mm_andnot_pd(b, a); }
+		static int bits(Mask mask) { return _mm_movemask_pd(mask); }
+		static Pack gather(const double* base, Pack indices) { return _mm_setr_pd(base[std::size_t(_mm_cvtsd_f64(indices))], base[std::size_t(_mm_cvtsd_f64(_mm_unpackhi_pd(indices, indices)))]); }
+		static Pack select(Mask mask, Pack ifTrue, Pack ifFalse) { return _mm_or_pd(_mm_and_pd(mask, ifTrue), _mm_andnot_pd(mask, ifFalse)); }
+	};
+#else
+	using SimdLanes = ScalarLanes;
+#endif
+
+	// приведение аргумента и многочлены синуса/косинуса на [-pi/4; pi/4] - по Cephes (sin.c), без ветвлений, чтобы одинаково работать в каждой полосе
+	constexpr double fourOverPi = 1.27323954473516268615;
+	constexpr double reductionPart1 = 7.85398125648498535156E-1;
+	constexpr double reductionPart2 = 3.77489470793079817668E-8;
+	constexpr double reductionPart3 = 2.69515142907905952645E-15;
+	constexpr double sinCoeffs[] = { 1.58962301576546568060E-10, -2.50507477628578072866E-8, 2.75573136213857245213E-6, -1.98412698295895385996E-4, 8.33333333332211858878E-3, -1.66666666666666307295E-1 };
+	constexpr double cosCoeffs[] = { -1.13585365213876817300E-11, 2.08757008419747316778E-9, -2.75573141792967388112E-7, 2.48015872888517045348E-5, -1.38888888888730564116E-3, 4.16666666666665929218E-2 };
+
+	// арктангенс на [0; 1] - по Cephes (atan.c): P(z) / Q(z) после приведения к |x| <= tan(pi/8)
+	constexpr double atanNumCoeffs[] = { -8.750608600031904122785E-1, -1.615753718733365076637E1, -7.500855792314704667340E1, -1.228866684490136173410E2, -6.485021904942025371773E1 };
+	constexpr double atanDenCoeffs[] = { 2.485846490142306297962E1, 1.650270098316988542046E2, 4.328810604912902668951E2, 4.853903996359136964868E2, 1.945506571482613964425E2 };
+	constexpr double atanMoreBits = 6.123233995736765886130E-17;
+	constexpr double piOverTwo = 1.57079632679489661923;
+	constexpr double piOverFour = 0.78539816339744830962;
+	constexpr double pi = 3.14159265358979323846;
+
+	template <typename Lanes> typename Lanes::Pack evaluatePolynomial(typename Lanes::Pack x, const double (&c)[6]) // схема Горнера, развёрнутая вручную
+	{
+		using L = Lanes;
+
+		auto result = L::add(L::mul(L::set(c[0]), x), L::set(c[1]));
+		result = L::add(L::mul(result, x), L::set(c[2]));
+		result = L::add(L::mul(result, x), L::set(c[3]));
+		result = L::add(L::mul(result, x), L::set(c[4]));
+
+		return L::add(L::mul(result, x), L::set(c[5]));
+	}
+
+	template <typename Lanes> void computeSinCosInOctant(typename Lanes::Pack angle, typename Lanes::Pack& sine, typename Lanes::Pack& cosine) // только для |angle| <= pi/4 - без приведения аргумента
+	{
+		using L = Lanes;
+		auto angleSq = L::mul(angle, angle);
+
+		sine = L::add(angle, L::mul(L::mul(angle, angleSq), evaluatePolynomial<Lanes>(angleSq, sinCoeffs)));
+		cosine = L::add(L::sub(L::set(1), L::mul(L::set(0.5), angleSq)), L::mul(L::mul(angleSq, angleSq), evaluatePolynomial<Lanes>(angleSq, cosCoeffs)));
+	}
+
+	template <typename Lanes> void computeSinCos(typename Lanes::Pack angle, typename Lanes::Pack& sine, typename Lanes::Pack& cosine)
+	{
+		using L = Lanes;
+		auto zero = L::set(0), one = L::set(1), half = L::set(0.5), two = L::set(2);
+		auto absAngle = L::abs(angle);
+
+		// номер октанта, округлённый до чётного, и остаток в [-pi/4; pi/4]
+		auto octant = L::floor(L::mul(absAngle, L::set(fourOverPi)));
+		octant = L::add(octant, L::sub(octant, L::mul(two, L::floor(L::mul(octant, half)))));
+		auto reduced = L::sub(L::sub(L::sub(absAngle, L::mul(octant, L::set(reductionPart1))), L::mul(octant, L::set(reductionPart2))), L::mul(octant, L::set(reductionPart3)));
+		auto reducedSq = L::mul(reduced, reduced);
+
+		auto sinPoly = evaluatePolynomial<Lanes>(reducedSq, sinCoeffs);
+		auto cosPoly = evaluatePolynomial<Lanes>(reducedSq, cosCoeffs);
+
+		auto sinValue = L::add(reduced, L::mul(L::mul(reduced, reducedSq), sinPoly));
+		auto cosValue = L::add(L::sub(one, L::mul(half, reducedSq)), L::mul(L::mul(reducedSq, reducedSq), cosPoly));
+
+		// четверть окружности 0..3 определяет, какой многочлен и с каким знаком даёт синус и косинус
+		auto quadrant = L::mul(octant, half);
+		quadrant = L::sub(quadrant, L::mul(L::set(4), L::floor(L::mul(quadrant, L::set(0.25)))));
+		auto swapMask = L::equal(L::sub(quadrant, L::mul(two, L::floor(L::mul(quadrant, half)))), one);
+
+		sine = L::select(swapMask, cosValue, sinValue);
+		cosine = L::select(swapMask, sinValue, cosValue);
+		sine = L::select(L::less(quadrant, two), sine, L::sub(zero, sine));
+		cosine = L::select(L::less(L::abs(L::sub(quadrant, L::set(1.5))), one), L::sub(zero, cosine), cosine);
+		sine = L::select(L::less(angle, zero), L::sub(zero, sine), sine);
+	}
+
+	template <typename Lanes> typename Lanes::Pack computeAtan2(typename Lanes::Pack y, typename Lanes::Pack x) // угол вектора (x, y) в (-pi; pi], как у std::atan2
+	{
+		using L = Lanes;
+		auto zero = L::set(0), one = L::set(1);
+		auto absX = L::abs(x), absY = L::abs(y);
+
+		// отношение меньшей составляющей к большей лежит в [0; 1]; выше 0.66 оно приводится через atan(r) = pi/4 + atan((r - 1) / (r + 1)) - одним делением
+		auto isSteep = L::less(absX, absY);
+		auto smaller = L::min(absX, absY), larger = L::max(absX, absY);
+		auto isReduced = L::less(L::mul(L::set(0.66), larger), smaller);
+		auto numerator = L::select(isReduced, L::sub(smaller, larger), smaller);
+		auto denominator = L::select(isReduced, L::add(smaller, larger), L::select(L::equal(larger, zero), one, larger));
+		auto reduced = L::div(numerator, denominator);
+		auto reducedSq = L::mul(reduced, reduced);
+
+		auto polyNum = L::add(L::mul(L::set(atanNumCoeffs[0]), reducedSq), L::set(atanNumCoeffs[1]));
+		polyNum = L::add(L::mul(polyNum, reducedSq), L::set(atanNumCoeffs[2]));
+		polyNum = L::add(L::mul(polyNum, reducedSq), L::set(atanNumCoeffs[3]));
+		polyNum = L::add(L::mul(polyNum, reducedSq), L::set(atanNumCoeffs[4]));
+		auto polyDen = L::add(reducedSq, L::set(atanDenCoeffs[0]));
+		polyDen = L::add(L::mul(polyDen, reducedSq), L::set(atanDenCoeffs[1]));
+		polyDen = L::add(L::mul(polyDen, reducedSq), L::set(atanDenCoeffs[2]));
+		polyDen = L::add(L::mul(polyDen, reducedSq), L::set(atanDenCoeffs[3]));
+		polyDen = L::add(L::mul(polyDen, reducedSq), L::set(atanDenCoeffs[4]));
+
+		auto angle = L::add(reduced, L::mul(reduced, L::div(L::mul(reducedSq, polyNum), polyDen)));
+		angle = L::add(angle, L::select(isReduced, L::set(piOverFour + 0.5 * atanMoreBits), zero));
+
+		// обратно к углу вектора: через дополнение до pi/2, отражение по x и знак y
+		angle = L::select(isSteep, L::sub(L::set(piOverTwo), angle), angle);
+		angle = L::select(L::less(x, zero), L::sub(L::set(pi), angle), angle);
+
+		return L::select(L::less(y, zero), L::sub(zero, angle), angle);
+	}
+}
+
+#endif // SIMD_MATH_HDR_IG
@@ -0,0 +1,71 @@
+#ifndef SPSC_RING_HDR_IG
+#define SPSC_RING_HDR_IG
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+template <typename T> class SpscRingBuffer // кольцевой буфер без блокировок для одного писателя и одного читателя
+{
+	public:
+		explicit SpscRingBuffer(std::size_t minCapacity) : _capacity(_roundUpToPowerOfTwo(minCapacity)), _mask(_capacity - 1), _items(new T[_capacity]) {}
+		SpscRingBuffer(const SpscRingBuffer&) = delete;
+		SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+		std::size_t getCapacity() const { return _capacity; }
+
+		bool tryPush(const T& item) // вызывается только писателем; false - буфер заполнен
+		{
+			const auto tail = _tail.load(std::memory_order_relaxed);
+
+			if (tail - _cachedHead == _capacity)
+			{
+				_cachedHead = _head.load(std::memory_order_acquire);
+
+				if (tail - _cachedHead == _capacity)
+					return false;
+			}
+
+			_items[tail & _mask] = item;
+			_tail.store(tail + 1, std::memory_order_release);
+
+			return true;
+		}
+
+		template <typename Consumer> std::size_t drain(Consumer&& consumer, std::size_t maxItems = ~std::size_t(0)) // вызывается только читателем; отдаёт накопленное одной пачкой
+		{
+			const auto head = _head.load(std::memory_order_relaxed);
+			const auto available = _tail.load(std::memory_order_acquire) - head;
+			const auto count = available < maxItems ? available : maxItems;
+
+			for (std::size_t i = 0; i < count; ++i)
+				consumer(_items[(head + i) & _mask]);
+
+			_head.store(head + count, std::memory_order_release);
+
+			return count;
+		}
+
+		std::size_t getSizeApprox() const { return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire); }
+		bool isEmpty() const { return !getSizeApprox(); }
+
+	private:
+		static std::size_t _roundUpToPowerOfTwo(std::size_t value)
+		{
+			std::size_t result = 2;
+
+			while (result < value)
+				result <<= 1;
+
+			return result;
+		}
+
+		const std::size_t _capacity;
+		const std::size_t _mask;
+		std::unique_ptr<T[]> _items;
+		alignas(64) std::atomic<std::size_t> _head{ 0 };	// следующий элемент для читателя - меняет только читатель
+		alignas(64) std::atomic<std::size_t> _tail{ 0 };	// следующая свободная ячейка - меняет только писатель
+		std::size_t _cachedHead{ 0 };						// последнее увиденное писателем значение _head, чтобы реже читать чужую строку кэша
+};
+
+#endif // SPSC_RING_HDR_IG
@@ -0,0 +1,139 @@
+#ifndef TRACE_RECORDER_HDR_IG
+#define TRACE_RECORDER_HDR_IG
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+// запись событий для просмотра в chrome://tracing или Perfetto: включается опцией MGE_ENABLE_TRACE (определение MGE_TRACE),
+// без неё макросы ничего не порождают; имена событий и потоков - строковые литералы, указатели на них хранятся как есть
+#ifdef MGE_TRACE
+#define MGE_TRACE_CONCAT_IMPL(a, b) a##b
+#define MGE_TRACE_CONCAT(a, b) MGE_TRACE_CONCAT_IMPL(a, b)
+#define MGE_TRACE_SCOPE(name) TraceRecorder::ScopedEvent MGE_TRACE_CONCAT(traceScope, __LINE__)(name)
+#define MGE_TRACE_THREAD_NAME(name) TraceRecorder::setThreadName(name)
+#else
+#define MGE_TRACE_SCOPE(name) ((void)0)
+#define MGE_TRACE_THREAD_NAME(name) ((void)0)
+#endif
+
+#ifndef MGE_TRACE_MAX_EVENTS_PER_THREAD
+#define MGE_TRACE_MAX_EVENTS_PER_THREAD (1 << 20)
+#endif
+
+namespace TraceRecorder // у каждого потока свой буфер событий с одним писателем - запись идёт без блокировок
+{
+	struct Event
+	{
+		const char* name;
+		std::uint64_t startNs;		// по steady_clock
+		std::uint64_t durationNs;
+	};
+
+	constexpr std::size_t chunkCapacity = 4096;
+
+	// сверх этого события потока за прогон отбрасываются и только считаются
+	inline std::atomic<std::size_t> maxEventsPerThread{ std::size_t(MGE_TRACE_MAX_EVENTS_PER_THREAD) };
+	inline std::atomic<std::uint64_t> resetEpoch{ 0 };	// номер последнего reset()
+
+	struct EventChunk
+	{
+		Event events[chunkCapacity];
+		std::atomic<EventChunk*> next{ nullptr };
+	};
+
+	// буфер потока: в пределах прогона куски только добавляются, записанное не перемещается, поэтому читатель может обходить его во время записи
+	struct ThreadBuffer
+	{
+		EventChunk head;
+		EventChunk* tail{ &head };
+		std::atomic<std::size_t> publishedCount{ 0 };	// события до этого номера записаны полностью
+		std::atomic<std::uint64_t> droppedCount{ 0 };
+		std::atomic<const char*> name{ nullptr };
+		std::uint32_t threadId{ 0 };					// порядковый номер потока в записи
+		std::uint64_t epoch{ 0 };						// номер сброса, после которого записаны события; меняется под блокировкой реестра
+		bool isReleased{ false };						// поток завершился; под блокировкой реестра
+
+		~ThreadBuffer();
+		void startEpoch(std::uint64_t newEpoch);		// отбрасывает события прошлых прогонов и лишние куски
+		void append(const Event& event) // вызывается только потоком-владельцем
+		{
+			const auto currentEpoch = resetEpoch.load(std::memory_order_relaxed);
+
+			if (epoch != currentEpoch)
+				startEpoch(currentEpoch);
+
+			const auto count = publishedCount.load(std::memory_order_relaxed);
+
+			if (count >= maxEventsPerThread.load(std::memory_order_relaxed))
+			{
+				droppedCount.store(droppedCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+				return;
+			}
+
+			if (count && count % chunkCapacity == 0)
+			{
+				auto chunk = new EventChunk;
+
+				tail->next.store(chunk, std::memory_order_release);
+				tail = chunk;
+			}
+
+			tail->events[count % chunkCapacity] = event;
+			publishedCount.store(count + 1, std::memory_order_release);
+		}
+	};
+
+	ThreadBuffer* registerThreadBuffer();				// заводит буфер нового потока
+	void releaseThreadBuffer(ThreadBuffer* threadBuffer);	// поток завершился; события остаются в записи до reset()
+
+	struct ThreadBufferHandle // буфер отдаётся реестру при завершении потока
+	{
+		ThreadBuffer* buffer{ registerThreadBuffer() };
+
+		ThreadBufferHandle() = default;
+		ThreadBufferHandle(const ThreadBufferHandle&) = delete;
+		ThreadBufferHandle& operator=(const ThreadBufferHandle&) = delete;
+		~ThreadBufferHandle() { releaseThreadBuffer(buffer); }
+	};
+
+	inline ThreadBuffer* getThreadBuffer()
+	{
+		thread_local ThreadBufferHandle handle;
+
+		return handle.buffer;
+	}
+
+	inline std::uint64_t getNowNs() { return std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count()); }
+	inline void setThreadName(const char* name) { getThreadBuffer()->name.store(name, std::memory_order_relaxed); }
+	inline void setMaxEventsPerThread(std::size_t count) { maxEventsPerThread.store(count, std::memory_order_relaxed); }
+
+	// события всех потоков в формате Chrome trace JSON; можно вызывать во время записи - попадёт всё, что успело завершиться
+	void writeChromeTrace(std::ostream& output);
+	bool saveChromeTrace(const std::string& filePath);
+	std::uint64_t getDroppedEventCount();	// события, отброшенные сверх maxEventsPerThread с последнего reset()
+
+	// начинает новый прогон: буферы завершившихся потоков освобождаются сразу, остальные потоки очищают свои при следующем событии;
+	// можно вызывать во время записи
+	void reset();
+
+	class ScopedEvent
+	{
+		public:
+			// буфер берётся до отметки начала - его заведение не попадает в длительность события
+			explicit ScopedEvent(const char* name) : _buffer(getThreadBuffer()), _name(name), _startNs(getNowNs()) {}
+			ScopedEvent(const ScopedEvent&) = delete;
+			ScopedEvent& operator=(const ScopedEvent&) = delete;
+			~ScopedEvent() { _buffer->append({ _name, _startNs, getNowNs() - _startNs }); }
+
+		private:
+			ThreadBuffer* _buffer;
+			const char* _name;
+			std::uint64_t _startNs;
+	};
+}
+
+#endif // TRACE_RECORDER_HDR_IG
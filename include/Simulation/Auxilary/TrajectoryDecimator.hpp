@@ -0,0 +1,119 @@
+#ifndef TRAJECTORY_DECIMATOR_HDR_IG
+#define TRAJECTORY_DECIMATOR_HDR_IG
+
+#include <algorithm>
+#include <cmath>
+#include "Simulation/Auxilary/utils.hpp"
+
+// потоковое прореживание ломаной методом "рукава" (Zhao-Saalfeld): каждая точка обрабатывается один раз за O(1),
+// все отброшенные точки лежат не дальше tolerance от отрезка между соседними оставленными, первая и последняя точки сохраняются
+class TrajectoryDecimator
+{
+	public:
+		explicit TrajectoryDecimator(double tolerance = 0) : _tolerance(tolerance) {}
+
+		// уменьшение допуска действует сразу, в том числе на уже начатый отрезок; 0 - оставлять все неколлинеарные точки
+		void setTolerance(double tolerance) { _tolerance = tolerance; }
+		double getTolerance() const { return _tolerance; }
+
+		void reset()
+		{
+			_hasAnchor = false;
+			_hasPending = false;
+			_hasSleeve = false;
+		}
+
+		// sink(x, y) вызывается для каждой оставленной точки в порядке следования
+		template <typename Sink> void push(double x, double y, Sink&& sink)
+		{
+			if (!_hasAnchor)
+			{
+				_setAnchor(x, y);
+				sink(x, y);
+				return;
+			}
+
+			if (!_fitsSleeve(x, y))
+			{
+				// точка вышла из рукава - последняя подходившая точка становится новой опорной
+				sink(_pendingX, _pendingY);
+				_setAnchor(_pendingX, _pendingY);
+				_fitsSleeve(x, y); // из новой опорной точки рукав строится заново, точка в него всегда попадает
+			}
+
+			_pendingX = x;
+			_pendingY = y;
+			_hasPending = true;
+		}
+
+		// отдаёт последнюю принятую точку; после этого прореживание продолжается от неё
+		template <typename Sink> void finish(Sink&& sink)
+		{
+			if (!_hasPending)
+				return;
+
+			sink(_pendingX, _pendingY);
+			_setAnchor(_pendingX, _pendingY);
+		}
+
+		// последняя принятая, но ещё не отданная точка - для промежуточной отрисовки хвоста
+		bool hasPending() const { return _hasPending; }
+		double getPendingX() const { return _pendingX; }
+		double getPendingY() const { return _pendingY; }
+
+	private:
+		double _tolerance;
+		double _anchorX{ 0 }, _anchorY{ 0 };
+		double _pendingX{ 0 }, _pendingY{ 0 };
+		double _sleeveCenter{ 0 };		// направление оси допустимого сектора из опорной точки
+		double _sleeveHalfWidth{ 0 };
+		bool _hasAnchor{ false };
+		bool _hasPending{ false };
+		bool _hasSleeve{ false };
+
+		void _setAnchor(double x, double y)
+		{
+			_anchorX = x;
+			_anchorY = y;
+			_hasAnchor = true;
+			_hasPending = false;
+			_hasSleeve = false;
+		}
+
+		// сужает сектор направлений из опорной точки, в котором отрезок проходит не дальше допуска от всех точек; false - сектор пуст
+		bool _fitsSleeve(double x, double y)
+		{
+			auto deltaX = x - _anchorX;
+			auto deltaY = y - _anchorY;
+			auto distance = std::hypot(deltaX, deltaY);
+
+			if (distance <= _tolerance) // точка в круге допуска подходит любому направлению
+				return true;
+
+			auto direction = std::atan2(deltaY, deltaX);
+			auto halfWidth = std::asin(_tolerance / distance);
+
+			if (!_hasSleeve)
+			{
+				_sleeveCenter = direction;
+				_sleeveHalfWidth = halfWidth;
+				_hasSleeve = true;
+				return true;
+			}
+
+			auto offset = std::remainder(direction - _sleeveCenter, 2 * M_PI); // разность углов в [-pi, pi]
+
+			if (std::abs(offset) > _sleeveHalfWidth)
+				return false;
+
+			auto lower = std::max(-_sleeveHalfWidth, offset - halfWidth);
+			auto upper = std::min(_sleeveHalfWidth, offset + halfWidth);
+
+			_sleeveCenter += (lower + upper) / 2;
+			_sleeveHalfWidth = (upper - lower) / 2;
+
+			return true;
+		}
+};
+
+#endif // TRAJECTORY_DECIMATOR_HDR_IG
@@ -0,0 +1,56 @@
+#ifndef UNIFORM_GRID_HDR_IG
+#define UNIFORM_GRID_HDR_IG
+
+#include "Simulation/Auxilary/VecMath.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+class UniformGrid // равномерная сетка для отбора близких точек: номера точек отсортированы по ячейкам, ячейка находится бинарным поиском
+{
+	public:
+		void rebuild(const std::vector<Vec2d>& positions, const std::vector<bool>& isIncluded, double cellSize); // раскладывает по ячейкам точки, для которых isIncluded[i]
+		template <typename Visitor> void forEachNear(const Vec2d& point, double radius, Visitor&& visitor) const // обходит точки в ячейках, задевающих квадрат 2 * radius вокруг point
+		{
+			forEachInBox(Vec2d(point.x() - radius, point.y() - radius), Vec2d(point.x() + radius, point.y() + radius), std::forward<Visitor>(visitor));
+		}
+		template <typename Visitor> void forEachInBox(const Vec2d& minCorner, const Vec2d& maxCorner, Visitor&& visitor) const // обходит точки в ячейках, задевающих прямоугольник
+		{
+			if (_entries.empty())
+				return;
+
+			auto minX = _cellOf(minCorner.x()), maxX = _cellOf(maxCorner.x());
+			auto minY = _cellOf(minCorner.y()), maxY = _cellOf(maxCorner.y());
+
+			for (auto cellX = minX; cellX <= maxX; ++cellX)
+			{
+				for (auto cellY = minY; cellY <= maxY; ++cellY)
+				{
+					auto key = _keyOf(cellX, cellY);
+					auto entry = std::lower_bound(_entries.begin(), _entries.end(), key, [](const Entry& e, std::uint64_t k) { return e.key < k; });
+
+					for (; entry != _entries.end() && entry->key == key; ++entry)
+						visitor(entry->index);
+				}
+			}
+		}
+		double getCellSize() const { return _cellSize; }
+		std::size_t size() const { return _entries.size(); }
+
+	private:
+		struct Entry
+		{
+			std::uint64_t key;
+			std::size_t index;
+		};
+		double _cellSize{ 1 };
+		std::vector<Entry> _entries;
+		std::int64_t _cellOf(double coordinate) const { return std::int64_t(std::floor(coordinate / _cellSize)); }
+		static std::uint64_t _keyOf(std::int64_t cellX, std::int64_t cellY) { return (std::uint64_t(std::uint32_t(cellX)) << 32) | std::uint32_t(cellY); }
+};
+
+#endif // UNIFORM_GRID_HDR_IG
@@ -0,0 +1,36 @@
+#ifndef LOOKUP_TABLE_HDR_IG
+#define LOOKUP_TABLE_HDR_IG
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+class UniformLookupTable // таблица функции одной переменной, пересчитанная на равномерную сетку - значение находится по индексу без поиска и ветвлений
+{
+	public:
+		UniformLookupTable() = default;
+		UniformLookupTable(std::vector<std::pair<double, double>> knots, double step); // строит сетку с шагом step по узлам (аргумент, значение), между узлами - линейно
+		double operator()(double arg) const
+		{
+			// вне сетки значение удерживается на крайнем узле
+			double position = std::clamp((arg - _minArg) * _invStep, 0., _lastPosition);
+			auto index = std::min(static_cast<std::size_t>(position), _values.size() - 2);
+			double fraction = position - index;
+
+			return _values[index] + (_values[index + 1] - _values[index]) * fraction;
+		}
+		double getMinArg() const { return _minArg; }
+		double getMaxArg() const { return _minArg + _lastPosition / _invStep; }
+		double getInvStep() const { return _invStep; }
+		double getLastPosition() const { return _lastPosition; }
+		const std::vector<double>& getValues() const { return _values; } // значения в узлах сетки - для пакетного расчёта по полосам
+
+	private:
+		double _minArg{ 0 };
+		double _invStep{ 1 };
+		double _lastPosition{ 0 };
+		std::vector<double> _values{ 0, 0 };
+};
+
+#endif // LOOKUP_TABLE_HDR_IG
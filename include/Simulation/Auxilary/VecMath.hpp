@@ -0,0 +1,90 @@
+#ifndef VEC_MATH_HDR_IG
+#define VEC_MATH_HDR_IG
+
+#include <cmath>
+
+// векторы двойной точности для расчётного ядра - без Qt, интерфейс повторяет QVector2D/QVector3D, чтобы код моделей не менялся
+
+class Vec2d
+{
+	public:
+		constexpr Vec2d() = default;
+		constexpr Vec2d(double x, double y) : _x(x), _y(y) {}
+		constexpr double x() const { return _x; }
+		constexpr double y() const { return _y; }
+		constexpr void setX(double x) { _x = x; }
+		constexpr void setY(double y) { _y = y; }
+		constexpr double lengthSquared() const { return _x * _x + _y * _y; }
+		double length() const { return std::hypot(_x, _y); }
+		Vec2d normalized() const
+		{
+			double len = length();
+
+			return len > 0 ? Vec2d(_x / len, _y / len) : Vec2d();
+		}
+		constexpr Vec2d& operator+=(const Vec2d& other) { _x += other._x; _y += other._y; return *this; }
+		constexpr Vec2d& operator-=(const Vec2d& other) { _x -= other._x; _y -= other._y; return *this; }
+		constexpr Vec2d& operator*=(double factor) { _x *= factor; _y *= factor; return *this; }
+		constexpr Vec2d& operator/=(double divisor) { _x /= divisor; _y /= divisor; return *this; }
+		constexpr bool operator==(const Vec2d& other) const { return _x == other._x && _y == other._y; }
+		constexpr bool operator!=(const Vec2d& other) const { return !(*this == other); }
+
+	private:
+		double _x{ 0 };
+		double _y{ 0 };
+};
+
+constexpr Vec2d operator+(Vec2d a, const Vec2d& b) { return a += b; }
+constexpr Vec2d operator-(Vec2d a, const Vec2d& b) { return a -= b; }
+constexpr Vec2d operator-(const Vec2d& a) { return Vec2d(-a.x(), -a.y()); }
+constexpr Vec2d operator*(Vec2d a, double factor) { return a *= factor; }
+constexpr Vec2d operator*(double factor, Vec2d a) { return a *= factor; }
+constexpr Vec2d operator/(Vec2d a, double divisor) { return a /= divisor; }
+constexpr double dot(const Vec2d& a, const Vec2d& b) { return a.x() * b.x() + a.y() * b.y(); }
+constexpr double cross(const Vec2d& a, const Vec2d& b) { return a.x() * b.y() - a.y() * b.x(); }	// z-составляющая векторного произведения
+constexpr Vec2d perpendicular(const Vec2d& a) { return Vec2d(-a.y(), a.x()); }						// поворот на +90 градусов
+
+class Vec3d
+{
+	public:
+		constexpr Vec3d() = default;
+		constexpr Vec3d(double x, double y, double z) : _x(x), _y(y), _z(z) {}
+		constexpr Vec3d(const Vec2d& planar, double z = 0) : _x(planar.x()), _y(planar.y()), _z(z) {}
+		constexpr double x() const { return _x; }
+		constexpr double y() const { return _y; }
+		constexpr double z() const { return _z; }
+		constexpr void setX(double x) { _x = x; }
+		constexpr void setY(double y) { _y = y; }
+		constexpr void setZ(double z) { _z = z; }
+		constexpr Vec2d toVec2d() const { return Vec2d(_x, _y); }
+		constexpr double lengthSquared() const { return _x * _x + _y * _y + _z * _z; }
+		double length() const { return std::sqrt(lengthSquared()); }
+		Vec3d normalized() const
+		{
+			double len = length();
+
+			return len > 0 ? Vec3d(_x / len, _y / len, _z / len) : Vec3d();
+		}
+		constexpr Vec3d& operator+=(const Vec3d& other) { _x += other._x; _y += other._y; _z += other._z; return *this; }
+		constexpr Vec3d& operator-=(const Vec3d& other) { _x -= other._x; _y -= other._y; _z -= other._z; return *this; }
+		constexpr Vec3d& operator*=(double factor) { _x *= factor; _y *= factor; _z *= factor; return *this; }
+		constexpr Vec3d& operator/=(double divisor) { _x /= divisor; _y /= divisor; _z /= divisor; return *this; }
+		constexpr bool operator==(const Vec3d& other) const { return _x == other._x && _y == other._y && _z == other._z; }
+		constexpr bool operator!=(const Vec3d& other) const { return !(*this == other); }
+
+	private:
+		double _x{ 0 };
+		double _y{ 0 };
+		double _z{ 0 };
+};
+
+constexpr Vec3d operator+(Vec3d a, const Vec3d& b) { return a += b; }
+constexpr Vec3d operator-(Vec3d a, const Vec3d& b) { return a -= b; }
+constexpr Vec3d operator-(const Vec3d& a) { return Vec3d(-a.x(), -a.y(), -a.z()); }
+constexpr Vec3d operator*(Vec3d a, double factor) { return a *= factor; }
+constexpr Vec3d operator*(double factor, Vec3d a) { return a *= factor; }
+constexpr Vec3d operator/(Vec3d a, double divisor) { return a /= divisor; }
+constexpr double dot(const Vec3d& a, const Vec3d& b) { return a.x() * b.x() + a.y() * b.y() + a.z() * b.z(); }
+constexpr Vec3d cross(const Vec3d& a, const Vec3d& b) { return Vec3d(a.y() * b.z() - a.z() * b.y(), a.z() * b.x() - a.x() * b.z(), a.x() * b.y() - a.y() * b.x()); }
+
+#endif // VEC_MATH_HDR_IG
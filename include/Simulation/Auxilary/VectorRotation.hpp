@@ -0,0 +1,28 @@
+#ifndef VECTOR_ROTATION_HDR_IG
+#define VECTOR_ROTATION_HDR_IG
+
+#include <cmath>
+#include <cstddef>
+
+struct SinCos // синус и косинус одного угла - поворот вектора вычисляется по ним без построения матрицы
+{
+	double sin{ 0 };
+	double cos{ 1 };
+
+	explicit SinCos(double angle) : sin(std::sin(angle)), cos(std::cos(angle)) {}
+	void rotate(double& x, double& y) const
+	{
+		double rotatedX = x * cos - y * sin;
+
+		y = x * sin + y * cos;
+		x = rotatedX;
+	}
+};
+
+// поворачивает векторы (xs[i], ys[i]) на углы angles[i] (рад); синус и косинус считаются векторно, по несколько углов за команду
+void rotateVectorsBatch(const double* angles, double* xs, double* ys, std::size_t count);
+
+// то же для двух наборов векторов одних объектов (например, скоростей и ускорений) - углы раскладываются на синус и косинус один раз
+void rotateVectorsBatch(const double* angles, double* xs, double* ys, double* secondXs, double* secondYs, std::size_t count);
+
+#endif // VECTOR_ROTATION_HDR_IG
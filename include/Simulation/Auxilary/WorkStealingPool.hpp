@@ -0,0 +1,29 @@
+#ifndef WORK_STEALING_POOL_HDR_IG
+#define WORK_STEALING_POOL_HDR_IG
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class WorkStealingPool // пул потоков с перехватом работы - каждый поток выбирает задачи из своего диапазона, а исчерпав его, забирает половину чужого
+{
+	public:
+		explicit WorkStealingPool(unsigned threadCount = 0);
+		unsigned getThreadCount() const { return _threadCount; }
+		void parallelFor(std::size_t taskCount, const std::function<void(std::size_t)>& task); // выполняет task(i) для i = 0..taskCount - 1 на всех потоках пула
+
+	private:
+		struct WorkRange // диапазон индексов задач, принадлежащий одному потоку
+		{
+			std::mutex lock;
+			std::size_t begin{ 0 };
+			std::size_t end{ 0 };
+		};
+		unsigned _threadCount;
+		static bool _popLocal(WorkRange& range, std::size_t& taskIndex);																// берёт очередную задачу из начала своего диапазона
+		static bool _steal(std::vector<std::unique_ptr<WorkRange>>& ranges, unsigned thiefIndex, std::size_t& taskIndex);	// забирает вторую половину диапазона другого потока
+};
+
+#endif // WORK_STEALING_POOL_HDR_IG
@@ -4,7 +4,6 @@
 #define _USE_MATH_DEFINES
 
 #include <cmath>
-#include <random>
 #include <string>
 #include <sstream>
 #include <locale>
@@ -12,17 +11,13 @@
 #include <iomanip>
 #include <fstream>
 #include <charconv>
-#include <QMap>
-#include <QString>
-#include <QVector2D>
-#include <QTransform>
+#include <map>
+#include <vector>
+#include "Simulation/Auxilary/VecMath.hpp"
 
 #define STANDARD_PRECISION 5
 
 using namespace std::chrono;
-using std::mt19937_64;
-using std::random_device;
-using std::uniform_real_distribution;
 using std::string;
 using std::stringstream;
 using std::fixed;
@@ -35,21 +30,20 @@ using std::ios_base;
 using std::vector;
 using std::to_string;
 
-struct Comma final : std::numpunct<char> // inspired by (copy-typed from) https://stackoverflow.com/a/42331536
-{
-	char do_decimal_point() const override { return ','; }
-};
-
 double degToRad(double degrees);
 
 double radToDeg(double radians);
 
-double getAngleBetweenVectorsRad(const QVector2D& firstVector, const QVector2D& secondVector);
+double getAngleBetweenVectorsRad(const Vec2d& firstVector, const Vec2d& secondVector);
+
+double getAngleBetweenVectorsRad(double firstX, double firstY, double secondX, double secondY);
+
+void rotateVec(double angle, Vec2d& vector, const bool isRad = true);
 
-void rotateVec(double angle, QVector2D& vector, const bool isRad = true);
+void rotateVecs(double angle, Vec2d* vectors, std::size_t count); // поворачивает несколько векторов на один угол (рад), синус и косинус считаются один раз
 
 double lerp(double currX, double prevX, double prevY, double nextX, double nextY);
 
-string convertDoubleToStringWithPrecision(double dbl, int precision = STANDARD_PRECISION, bool changeDecimal = true);
+string convertDoubleToStringWithPrecision(double dbl, int precision = STANDARD_PRECISION, bool changeDecimal = true); // для потокового вывода - CsvWriter
 
 #endif
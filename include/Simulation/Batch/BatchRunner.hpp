@@ -0,0 +1,75 @@
+#ifndef BATCH_RUNNER_HDR_IG
+#define BATCH_RUNNER_HDR_IG
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Simulation/Auxilary/Integrators.hpp"
+#include "Simulation/Auxilary/WorkStealingPool.hpp"
+
+struct EngagementSetup // исходные данные одного перехвата - те же, что задаются в окне программы
+{
+	double targetDistance	= 20000;	// начальная дальность до цели
+	double targetSpeed		= 200;		// скорость цели
+	double missileSpeed		= 200;		// начальная скорость ракеты
+	double navConstant		= 1.5;		// постоянная наведения
+	bool evasiveTarget		= true;		// выполняет ли цель противоракетный манёвр
+	double maxFlightTime	= 300;		// предельное время полёта, по истечении которого перехват считается несостоявшимся
+	IntegrationSettings integration;	// метод интегрирования уравнений движения
+};
+
+struct EngagementResult // итог одного перехвата
+{
+	std::uint64_t seed{ 0 };	// зерно ГСЧ, с которым выполнялся прогон
+	bool hit{ false };			// сработал ли НВ
+	double missDistance{ 0 };	// минимальное расстояние между ракетой и целью за время полёта
+	double timeOfFlight{ 0 };	// время полёта ракеты до срабатывания НВ или окончания прогона
+	std::uint64_t stepCount{ 0 };	// число шагов интегратора
+};
+
+struct DistributionSummary // описательная статистика выборки
+{
+	std::size_t count{ 0 };
+	double min{ 0 };
+	double max{ 0 };
+	double mean{ 0 };
+	double stdDev{ 0 };
+	double p50{ 0 };
+	double p90{ 0 };
+	double p99{ 0 };
+	double histogramMin{ 0 };
+	double histogramBinWidth{ 0 };
+	std::vector<std::size_t> histogram;
+
+	static DistributionSummary fromSamples(std::vector<double> samples, std::size_t binCount = 20);
+};
+
+struct BatchReport // сводка по серии перехватов
+{
+	std::size_t engagementCount{ 0 };
+	std::size_t hitCount{ 0 };
+	double hitProbability{ 0 };
+	DistributionSummary missDistance;	// по всем прогонам
+	DistributionSummary timeOfFlight;	// только по прогонам с поражением цели
+};
+
+class BatchRunner // выполняет серию перехватов со случайным маневрированием цели на всех ядрах, без GUI
+{
+	public:
+		BatchRunner(const EngagementSetup& setup, std::uint64_t masterSeed, unsigned threadCount = 0);
+		BatchReport run(std::size_t engagementCount);
+		const std::vector<EngagementResult>& getResults() const { return _results; }
+		void setLockstepEnabled(bool isEnabled) { _isLockstepEnabled = isEnabled; } // прогоны по Эйлеру идут связками LockstepBatch, а не по одному
+		static EngagementResult runEngagement(const EngagementSetup& setup, std::uint64_t seed);	// выполняет один перехват до поражения цели, потери скорости или истечения времени
+		static std::uint64_t deriveSeed(std::uint64_t masterSeed, std::uint64_t engagementIndex);	// вычисляет зерно прогона по общему зерну серии
+
+	private:
+		EngagementSetup _setup;
+		std::uint64_t _masterSeed;
+		WorkStealingPool _pool;
+		std::vector<EngagementResult> _results;
+		bool _isLockstepEnabled{ false };
+		void _runLockstep(std::size_t engagementCount);
+};
+
+#endif // BATCH_RUNNER_HDR_IG
@@ -0,0 +1,62 @@
+#ifndef ENVELOPE_SWEEP_HDR_IG
+#define ENVELOPE_SWEEP_HDR_IG
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Simulation/Auxilary/WorkStealingPool.hpp"
+#include "Simulation/Batch/BatchRunner.hpp"
+
+struct EnvelopeGrid // сетка исходных данных для построения зоны пуска
+{
+	std::vector<double> targetSpeeds{ 200 };
+	std::vector<double> missileSpeeds{ 200 };
+	std::vector<double> navConstants{ 1.5 };
+	double minDistance			= 500;		// нижняя граница поиска по дальности
+	double maxDistance			= 100000;	// верхняя граница поиска по дальности
+	double distanceTolerance	= 100;		// точность определения границ
+	std::size_t probeCount		= 8;		// число пробных дальностей для поиска точки внутри зоны
+	std::size_t evasiveSamples	= 8;		// число прогонов с манёвром цели для каждой проверяемой дальности
+	std::uint64_t masterSeed	= 1;
+	double maxFlightTime		= 300;
+	IntegrationSettings integration;
+
+	static std::vector<double> linspace(double first, double last, std::size_t count);
+};
+
+struct EnvelopeCell // границы зоны пуска для одного сочетания скоростей и постоянной наведения
+{
+	double targetSpeed{ 0 };
+	double missileSpeed{ 0 };
+	double navConstant{ 0 };
+	double rMin{ 0 };			// минимальная дальность пуска (цель без манёвра)
+	double rMax{ 0 };			// максимальная дальность пуска (цель без манёвра)
+	double rNoEscape{ 0 };		// дальность неизбежного поражения - цель поражается при любом из разыгранных манёвров
+	std::size_t runCount{ 0 };	// число выполненных прогонов
+	bool hasEnvelope() const { return rMax > 0; }
+};
+
+struct EnvelopeResult
+{
+	enum class Metric { RMin, RMax, RNoEscape };
+	EnvelopeGrid grid;
+	std::vector<EnvelopeCell> cells; // индекс = (navIndex * missileSpeeds + missileIndex) * targetSpeeds + targetIndex
+
+	const EnvelopeCell& at(std::size_t targetIndex, std::size_t missileIndex, std::size_t navIndex) const;
+	std::vector<double> heatmap(Metric metric, std::size_t navIndex) const; // значения по строкам скорости ракеты и столбцам скорости цели
+	std::size_t getTotalRunCount() const;
+};
+
+class EnvelopeSweep // строит границы зоны пуска параллельно по ячейкам сетки, в каждой - бисекцией по дальности за O(log n) прогонов
+{
+	public:
+		explicit EnvelopeSweep(const EnvelopeGrid& grid, unsigned threadCount = 0);
+		EnvelopeResult run();
+		static EnvelopeCell evaluateCell(const EnvelopeGrid& grid, double targetSpeed, double missileSpeed, double navConstant, std::uint64_t cellSeed);
+
+	private:
+		EnvelopeGrid _grid;
+		WorkStealingPool _pool;
+};
+
+#endif // ENVELOPE_SWEEP_HDR_IG
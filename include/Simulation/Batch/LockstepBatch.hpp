@@ -0,0 +1,46 @@
+#ifndef LOCKSTEP_BATCH_HDR_IG
+#define LOCKSTEP_BATCH_HDR_IG
+
+#include "Simulation/Auxilary/CounterRng.hpp"
+#include "Simulation/Batch/BatchRunner.hpp"
+#include "Simulation/SimObjects/Missile.hpp"
+#include "Simulation/SimObjects/Target.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class LockstepBatch // одинаковые перехваты, идущие по Эйлеру синхронно: состояние лежит по полям (SoA), шаг считается по несколько перехватов за команду SIMD, закончившиеся перехваты маскируются
+{
+	public:
+		static constexpr std::size_t chunkSize = 128; // перехватов в одной связке - состояние связки помещается в кэш L1/L2
+		LockstepBatch(const EngagementSetup& setup, std::shared_ptr<const Missile::MissileDesc> missileDesc = nullptr, std::shared_ptr<const Target::TargetDesc> targetDesc = nullptr); // без описаний берутся ракета и цель по умолчанию из справочника
+		static bool isApplicable(const EngagementSetup& setup) { return setup.integration.method == IntegrationMethod::Euler; } // связка повторяет только метод Эйлера с постоянным шагом
+		void run(const std::uint64_t* seeds, EngagementResult* results, std::size_t count); // выполняет count перехватов с зёрнами seeds[i] - итог совпадает с BatchRunner::runEngagement с точностью до округлений
+
+	private:
+		enum Field : std::size_t // поля состояния, по массиву на поле
+		{
+			MissileX, MissileY, MissileVelX, MissileVelY, FuelMass, IsLocked,
+			TargetX, TargetY, TargetVelX, TargetVelY, TargetAccX, TargetAccY, ManeuverTime, ManeuverDuration,
+			MissDistanceSq, FuzeTime, IsHit, IsActive,	// промах хранится в квадрате - корень извлекается один раз, в итоге
+			FieldCount
+		};
+		EngagementSetup _setup;
+		std::shared_ptr<const Missile::MissileDesc> _missileDesc;
+		std::shared_ptr<const Target::TargetDesc> _targetDesc;
+		std::array<std::vector<double>, FieldCount> _fields;
+		std::vector<CounterRng> _rngs;			// ГСЧ целей - манёвры разыгрываются по одному, вне SIMD
+		std::vector<std::size_t> _resultIndices;	// куда записать итог полосы - полосы переставляются при уплотнении
+		std::size_t _activeCount{ 0 };				// незакончившиеся перехваты занимают полосы 0.._activeCount - 1
+		double* _field(Field field) { return _fields[field].data(); }
+		void _initLane(std::size_t lane, std::uint64_t seed);
+		void _drawManeuver(std::size_t lane);
+		template <typename Lanes> void _step(double startTime, double endTime, bool isGuidanceEnabled); // один шаг Эйлера всех незакончившихся перехватов
+		void _retireFinished(double elapsedTime, std::uint64_t stepCount, EngagementResult* results); // записывает итоги закончившихся перехватов и переносит их полосы в конец
+		void _swapLanes(std::size_t first, std::size_t second);
+};
+
+#endif // LOCKSTEP_BATCH_HDR_IG
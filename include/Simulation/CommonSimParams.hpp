@@ -1,12 +1,13 @@
 #ifndef SIMULATION_PARAMETERS_HDR_IG
 #define SIMULATION_PARAMETERS_HDR_IG
 
-#include <QDebug>
-
 #define AIR_DENSITY		1.225f			// плотность воздуха
 #define FREEFALL_ACC	9.80665f		// ускорение свободного падения
 #define SIM_RESOLUTION	0.01f			// разрешение симуляции
 #define SPEED_OF_SOUND	343.f			// скорость звука
-#define OUT_FILE_NAME	"outputData.csv"
+#define OUT_FILE_NAME	"outputData.csv"		// CSV, получаемый из записи траектории
+#define OUT_TRAJ_FILE_NAME	"outputData.mgtr"	// двоичная запись траектории
+#define PROFILE_REPORT_FILE_NAME	"phaseProfile.txt"	// сводка по фазам такта (сборка с MGE_ENABLE_PROFILER)
+#define TRACE_FILE_NAME	"mgeTrace.json"	// события потоков в формате Chrome trace (сборка с MGE_ENABLE_TRACE)
 
 #endif // SIMULATION_PARAMETERS_HDR_IG
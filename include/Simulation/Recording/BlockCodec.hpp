@@ -0,0 +1,25 @@
+#ifndef BLOCK_CODEC_HDR_IG
+#define BLOCK_CODEC_HDR_IG
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace BlockCodec // сжатие блоков записей: перекладка по байтовым плоскостям и LZ-кодек в формате блока LZ4
+{
+	class CorruptDataError : public std::runtime_error
+	{
+		public:
+			using std::runtime_error::runtime_error;
+	};
+
+	void shuffle(const std::uint8_t* source, std::uint8_t* destination, std::size_t size, std::size_t elementSize);		// i-й байт каждого элемента - в i-ю плоскость
+	void unshuffle(const std::uint8_t* source, std::uint8_t* destination, std::size_t size, std::size_t elementSize);
+	void lzCompress(const std::uint8_t* source, std::size_t size, std::vector<std::uint8_t>& destination);					// дописывает сжатые данные в destination
+	void lzDecompress(const std::uint8_t* source, std::size_t size, std::uint8_t* destination, std::size_t rawSize);		// rawSize должен совпадать с исходным размером
+	void compress(const std::uint8_t* source, std::size_t size, std::size_t elementSize, std::vector<std::uint8_t>& destination);
+	void decompress(const std::uint8_t* source, std::size_t size, std::size_t elementSize, std::uint8_t* destination, std::size_t rawSize);
+}
+
+#endif // BLOCK_CODEC_HDR_IG
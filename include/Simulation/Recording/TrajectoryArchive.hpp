@@ -0,0 +1,76 @@
+#ifndef TRAJECTORY_ARCHIVE_HDR_IG
+#define TRAJECTORY_ARCHIVE_HDR_IG
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Simulation/Auxilary/MappedFile.hpp"
+#include "Simulation/Recording/TrajectoryFormat.hpp"
+
+// столбцовый архив траектории (.mgta) для чтения через отображение в память, все числа - little-endian, все смещения кратны 8:
+//	заголовок:	ArchiveHeader, дополненный нулями до 64 байт
+//	имена:		имена столбцов (u16 длина + байты), дополненные нулями до кратного 8 размера
+//	столбцы:	значения каждого столбца подряд в виде f64, столбцы в порядке TrajectoryFormat::Column
+//	индекс:		время каждой indexStride-й записи - по нему запись с нужным временем находится без чтения всего столбца времени
+namespace TrajectoryArchiveFormat
+{
+	constexpr char magic[4] = { 'M', 'G', 'T', 'A' };
+	constexpr std::uint16_t version = 1;
+	constexpr std::uint64_t defaultIndexStride = 4096; // 32 КБ столбца времени между соседними точками индекса
+
+	struct ArchiveHeader
+	{
+		char magic[4];
+		std::uint16_t version;
+		std::uint16_t columnCount;
+		std::uint32_t closeState;		// TrajectoryFormat::CloseState исходной записи
+		std::uint32_t reserved;
+		double simResolution;
+		std::uint64_t recordCount;
+		std::uint64_t indexStride;
+		std::uint64_t columnsOffset;
+		std::uint64_t indexOffset;
+	};
+
+	static_assert(sizeof(ArchiveHeader) == 56, "archive header layout must not depend on the compiler");
+	constexpr std::size_t headerSize = 64; // место под заголовок с запасом на будущие поля
+}
+
+class TrajectoryArchive // архив открывается без чтения данных: столбцы берутся прямо из отображённого файла, страницы подгружаются при обращении
+{
+	public:
+		struct RecordRange // записи [first, last)
+		{
+			std::size_t first{ 0 };
+			std::size_t last{ 0 };
+			std::size_t getSize() const { return last - first; }
+		};
+		explicit TrajectoryArchive(const std::string& filePath); // при ошибке открытия или повреждённом файле - std::runtime_error
+		const std::vector<std::string>& getColumnNames() const { return _columnNames; }
+		std::size_t getColumnCount() const { return _columnNames.size(); }
+		std::size_t getRecordCount() const { return _header.recordCount; }
+		double getSimResolution() const { return _header.simResolution; }
+		TrajectoryFormat::CloseState getCloseState() const { return static_cast<TrajectoryFormat::CloseState>(_header.closeState); }
+		const double* getColumn(std::size_t column) const { return _columns + column * _header.recordCount; } // getRecordCount() значений
+		double getValue(std::size_t column, std::size_t record) const { return getColumn(column)[record]; }
+		double getStartTime() const { return _header.recordCount ? getValue(TrajectoryFormat::Time, 0) : 0; }
+		double getEndTime() const { return _header.recordCount ? getValue(TrajectoryFormat::Time, _header.recordCount - 1) : 0; }
+		std::size_t findRecord(double time) const;							// первая запись со временем не меньше time; getRecordCount() - таких нет
+		RecordRange findWindow(double startTime, double endTime) const;		// записи со временем в [startTime, endTime]
+		void prefetch(const RecordRange& range) const;						// заранее подгружает диапазон во всех столбцах - для потокового просмотра окна
+
+	private:
+		MappedFile _file;
+		TrajectoryArchiveFormat::ArchiveHeader _header;
+		std::vector<std::string> _columnNames;
+		const double* _columns{ nullptr };
+		const double* _index{ nullptr };
+		std::size_t _indexSize{ 0 };
+};
+
+// перекладывает запись .mgtr в столбцовый архив за два прохода: подсчёт записей без распаковки и раскладка блоков по столбцам
+// время в записи должно не убывать - иначе std::runtime_error
+void convertTrajectoryToArchive(const std::string& trajectoryPath, const std::string& archivePath, std::size_t indexStride = TrajectoryArchiveFormat::defaultIndexStride);
+
+#endif // TRAJECTORY_ARCHIVE_HDR_IG
@@ -0,0 +1,53 @@
+#ifndef TRAJECTORY_FORMAT_HDR_IG
+#define TRAJECTORY_FORMAT_HDR_IG
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// двоичный формат записи траектории (.mgtr), все числа - little-endian:
+//	заголовок:	"MGTR", u16 версия, u16 флаги, f64 шаг моделирования, u16 число столбцов, имена столбцов (u16 длина + байты)
+//	блоки:		u32 число записей, u32 размер полезной нагрузки, u32 исходный размер, полезная нагрузка
+//				запись - столбцы подряд в виде f64; при сжатии нагрузка - записи, переложенные по байтовым плоскостям и сжатые LZ-кодеком
+//	окончание:	блок с нулевым числом записей и нулевым размером, за которым следует u32 состояние закрытия
+namespace TrajectoryFormat
+{
+	constexpr char magic[4] = { 'M', 'G', 'T', 'R' };
+	constexpr std::uint16_t version = 1;
+	constexpr std::uint16_t compressedFlag = 1 << 0;
+
+	enum class CloseState : std::uint32_t
+	{
+		Normal = 0,
+		Forced = 1	// запись прервана: прогон остановлен или снят флаг вывода в файл
+	};
+
+	enum Column : std::size_t // порядок столбцов записи - тот же, что в строках прежнего CSV
+	{
+		TargetX,
+		TargetY,
+		TargetSpeed,
+		MissileX,
+		MissileY,
+		MissileSpeed,
+		Time,
+		ColumnCount
+	};
+
+	inline const std::vector<std::string>& columnNames()
+	{
+		static const std::vector<std::string> names{ "Target X", "Target Y", "Target Speed (m/s)", "Missile X", "Missile Y", "Missile Speed (m/s)", "Time" };
+
+		return names;
+	}
+
+	struct Header
+	{
+		std::uint16_t flags{ 0 };
+		double simResolution{ 0 };
+		std::vector<std::string> columns;
+	};
+}
+
+#endif // TRAJECTORY_FORMAT_HDR_IG
@@ -0,0 +1,30 @@
+#ifndef TRAJECTORY_READER_HDR_IG
+#define TRAJECTORY_READER_HDR_IG
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include "Simulation/Recording/TrajectoryFormat.hpp"
+
+class TrajectoryReader // последовательно читает блоки двоичного файла траектории
+{
+	public:
+		explicit TrajectoryReader(const std::string& filePath); // при ошибке открытия или неверном заголовке - std::runtime_error
+		const TrajectoryFormat::Header& getHeader() const { return _header; }
+		std::size_t getColumnCount() const { return _header.columns.size(); }
+		bool readBlock(std::vector<double>& values);	// заменяет содержимое values записями очередного блока; false - блоков больше нет
+		std::size_t skipBlock();						// пропускает очередной блок без распаковки и возвращает число записей в нём; 0 - блоков больше нет
+		TrajectoryFormat::CloseState getCloseState() const { return _closeState; } // известно после чтения последнего блока
+
+	private:
+		std::ifstream _file;
+		TrajectoryFormat::Header _header;
+		TrajectoryFormat::CloseState _closeState{ TrajectoryFormat::CloseState::Normal };
+		std::vector<std::uint8_t> _payload;
+		bool _isFinished{ false };
+		bool _readBlockHeader(std::uint32_t& recordCount, std::uint32_t& payloadSize, std::uint32_t& rawSize);
+};
+
+void convertTrajectoryToCsv(const std::string& trajectoryPath, const std::string& csvPath); // пересчитывает запись в прежний CSV (";" и десятичная запятая)
+
+#endif // TRAJECTORY_READER_HDR_IG
@@ -0,0 +1,54 @@
+#ifndef TRAJECTORY_RECORDER_HDR_IG
+#define TRAJECTORY_RECORDER_HDR_IG
+
+#include <array>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Simulation/Recording/TrajectoryFormat.hpp"
+
+class TrajectoryRecorder // пишет траекторию в двоичный файл блоками из фонового потока - поток моделирования только копирует числа в буфер
+{
+	public:
+		using Record = std::array<double, TrajectoryFormat::ColumnCount>;
+		struct Options
+		{
+			bool compress{ true };					// сжимать блоки
+			std::size_t recordsPerBlock{ 4096 };	// записей в блоке
+			std::size_t maxQueuedBlocks{ 64 };		// при отставании записи поток моделирования ждёт, а не копит память
+		};
+		TrajectoryRecorder(const std::string& filePath, double simResolution);
+		TrajectoryRecorder(const std::string& filePath, double simResolution, const Options& options);
+		~TrajectoryRecorder();
+		bool isOpen() const { return _isOpen; }
+		void append(const Record& record)
+		{
+			_currentBlock.insert(_currentBlock.end(), record.begin(), record.end());
+
+			if (_currentBlock.size() >= _blockValueCount)
+				_submitBlock();
+		}
+		void close(TrajectoryFormat::CloseState closeState = TrajectoryFormat::CloseState::Normal); // дописывает неполный блок, ждёт окончания записи и закрывает файл
+
+	private:
+		Options _options;
+		std::size_t _blockValueCount;
+		std::ofstream _file;
+		bool _isOpen{ false };
+		std::vector<double> _currentBlock;
+		std::deque<std::vector<double>> _queuedBlocks;
+		std::vector<std::vector<double>> _spareBlocks;	// буферы записанных блоков используются повторно
+		std::mutex _queueLock;
+		std::condition_variable _queueChanged;
+		bool _isClosing{ false };
+		std::thread _writer;
+		void _submitBlock();
+		void _writerLoop();
+		void _writeBlock(const std::vector<double>& block, std::vector<std::uint8_t>& scratch);
+};
+
+#endif // TRAJECTORY_RECORDER_HDR_IG
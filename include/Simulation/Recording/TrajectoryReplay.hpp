@@ -0,0 +1,36 @@
+#ifndef TRAJECTORY_REPLAY_HDR_IG
+#define TRAJECTORY_REPLAY_HDR_IG
+
+#include <memory>
+#include <string>
+#include "Simulation/Recording/TrajectoryArchive.hpp"
+
+class TrajectoryReplay // воспроизведение записанного перехвата: модельное время, скорость воспроизведения и число уже наступивших записей
+{
+	public:
+		// .mgta открывается напрямую; запись .mgtr сначала перекладывается в архив рядом с ней, если его нет или он старше записи
+		explicit TrajectoryReplay(const std::string& filePath);
+		// путь к архиву записи, при необходимости построенному заново; на больших записях это долго - GUI вызывает её в фоне
+		static std::string prepareArchive(const std::string& filePath);
+		const TrajectoryArchive& getArchive() const { return *_archive; }
+		double getTime() const { return _time; }
+		double getSpeed() const { return _speed; }
+		bool isPlaying() const { return _isPlaying; }
+		bool isAtEnd() const { return _time >= _archive->getEndTime(); }
+		double getProgress() const;								// доля пройденного времени записи, 0..1
+		std::size_t getVisibleRecordCount() const;				// записи со временем не больше текущего
+		void seek(double time);									// время ограничивается границами записи
+		void seekProgress(double progress) { seek(_archive->getStartTime() + progress * (_archive->getEndTime() - _archive->getStartTime())); }
+		void setSpeed(double speed) { _speed = speed > 0 ? speed : _speed; }
+		void play();											// с конца записи воспроизведение начинается заново
+		void pause() { _isPlaying = false; }
+		void advance(double wallSeconds);						// продвигает время на wallSeconds * скорость; в конце записи останавливается
+
+	private:
+		std::unique_ptr<TrajectoryArchive> _archive;
+		double _time{ 0 };
+		double _speed{ 1 };
+		bool _isPlaying{ false };
+};
+
+#endif // TRAJECTORY_REPLAY_HDR_IG
@@ -0,0 +1,66 @@
+#ifndef SEEKER_INDEX_HDR_IG
+#define SEEKER_INDEX_HDR_IG
+
+#include "Simulation/Auxilary/UniformGrid.hpp"
+#include "Simulation/Auxilary/VecMath.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+struct SeekerCandidate // цель, видимая ГСН
+{
+	std::size_t targetIndex{ 0 };
+	double distance{ 0 };
+	double offBoresight{ 0 };	// угол между осью ГСН и линией визирования, рад
+	double closingSpeed{ 0 };	// скорость сближения, > 0 - цель приближается
+};
+
+class SeekerIndex // индекс целей для запросов ГСН: просматриваются только ячейки сетки, задевающие сектор поля зрения
+{
+	public:
+		void rebuild(const std::vector<Vec2d>& positions, const std::vector<Vec2d>& velocities, const std::vector<bool>& isIncluded, double cellSize, bool useGrid = true); // cellSize порядка четверти дальности ГСН
+		template <typename Visitor> void forEachInCone(const Vec2d& origin, const Vec2d& velocity, double halfAngle, double range, Visitor&& visitor) const // обходит цели в секторе halfAngle вокруг velocity на дальности до range
+		{
+			const Vec2d boresight = velocity.normalized();
+			const double cosHalfAngle = std::cos(halfAngle);
+
+			auto consider = [&](std::size_t targetIndex)
+			{
+				Vec2d lineOfSight = (*_positions)[targetIndex] - origin;
+				double distance = lineOfSight.length();
+
+				// точная проверка без acos: cos угла до линии визирования не меньше cos половины ПЗ
+				if (distance > range || distance <= 0 || dot(lineOfSight, boresight) < distance * cosHalfAngle)
+					return;
+
+				Vec2d relativeVelocity = (*_velocities)[targetIndex] - velocity;
+				visitor(SeekerCandidate{ targetIndex, distance, std::atan2(std::abs(cross(boresight, lineOfSight)), dot(boresight, lineOfSight)), -dot(relativeVelocity, lineOfSight) / distance });
+			};
+
+			if (_useGrid)
+			{
+				Vec2d minCorner, maxCorner;
+				_getConeBounds(origin, boresight, halfAngle, range, minCorner, maxCorner);
+				_grid.forEachInBox(minCorner, maxCorner, consider);
+			}
+			else
+			{
+				for (std::size_t i = 0; i < _isIncluded->size(); ++i)
+				{
+					if ((*_isIncluded)[i])
+						consider(i);
+				}
+			}
+		}
+
+	private:
+		UniformGrid _grid;
+		const std::vector<Vec2d>* _positions{ nullptr };
+		const std::vector<Vec2d>* _velocities{ nullptr };
+		const std::vector<bool>* _isIncluded{ nullptr };
+		bool _useGrid{ true };
+		static void _getConeBounds(const Vec2d& origin, const Vec2d& boresight, double halfAngle, double range, Vec2d& minCorner, Vec2d& maxCorner); // описанный вокруг сектора прямоугольник
+};
+
+#endif // SEEKER_INDEX_HDR_IG
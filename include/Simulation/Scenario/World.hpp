@@ -0,0 +1,91 @@
+#ifndef WORLD_HDR_IG
+#define WORLD_HDR_IG
+
+#include "Simulation/CommonSimParams.hpp"
+#include "Simulation/Auxilary/UniformGrid.hpp"
+#include "Simulation/Scenario/SeekerIndex.hpp"
+#include "Simulation/SimObjects/Missile.hpp"
+#include "Simulation/SimObjects/Target.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+enum class TargetSelectionPolicy // какую из видимых ГСН целей захватывать
+{
+	Nearest,				// ближайшую
+	SmallestOffBoresight,	// ближайшую к оси ГСН
+	HighestClosingSpeed,	// с наибольшей скоростью сближения
+	LeastEngaged			// на которую наводится меньше всего ракет, при равенстве - ближайшую
+};
+
+struct WorldSettings
+{
+	double maxFlightTime						= 300;		// по истечении этого времени все ракеты считаются израсходованными
+	double reacquisitionDelay					= 0;		// время после срыва захвата, в течение которого ГСН не ищет новую цель
+	TargetSelectionPolicy selectionPolicy		= TargetSelectionPolicy::Nearest;
+	bool allowReacquisition						= true;		// false - ракета, потерявшая цель, летит дальше без наведения
+	bool useBroadphase							= true;		// false - полный перебор пар ракета-цель (для сравнения)
+};
+
+struct FuzeEvent // срабатывание НВ ракеты
+{
+	std::size_t missileIndex{ 0 };
+	std::size_t targetIndex{ 0 };
+	double time{ 0 };			// момент входа цели в зону поражения
+	double missDistance{ 0 };	// наименьшее расстояние на шаге срабатывания
+};
+
+class World // залп из N ракет против налёта из M целей; проверки НВ и захвата идут через равномерную сетку, а не перебором всех пар
+{
+	public:
+		World(std::size_t missileCapacity, std::size_t targetCapacity, const WorldSettings& settings = WorldSettings()); // ёмкость резервируется сразу - адреса объектов не меняются
+		std::size_t addMissile(double initialSpeed, double initialX, double initialY, std::shared_ptr<const Missile::MissileDesc> desc = nullptr);
+		std::size_t addTarget(double initialSpeed, double initialX, double initialY, std::shared_ptr<const Target::TargetDesc> desc = nullptr);
+		void assignTarget(std::size_t missileIndex, std::size_t targetIndex) { _missiles[missileIndex].setTarget(&_targets[targetIndex]); }
+		Missile& getMissile(std::size_t index) { return _missiles[index]; }
+		Target& getTarget(std::size_t index) { return _targets[index]; }
+		std::size_t getMissileCount() const { return _missiles.size(); }
+		std::size_t getTargetCount() const { return _targets.size(); }
+		std::size_t getActiveMissileCount() const { return _activeMissileCount; }
+		std::size_t getAliveTargetCount() const { return _aliveTargetCount; }
+		bool isMissileActive(std::size_t index) const { return _isMissileActive[index]; }
+		bool isTargetAlive(std::size_t index) const { return _isTargetAlive[index]; }
+		bool isFinished() const { return !_activeMissileCount || !_aliveTargetCount; }
+		double getElapsedTime() const { return _elapsedTime; }
+		const std::vector<FuzeEvent>& getFuzeEvents() const { return _fuzeEvents; }
+		void iterate(double elapsedTime = SIM_RESOLUTION);
+		void seed(std::uint64_t masterSeed); // задаёт зёрна всех объектов и заново разыгрывает манёвры целей - вызывается до начала моделирования
+
+	private:
+		WorldSettings _settings;
+		std::vector<Missile> _missiles;
+		std::vector<Target> _targets;
+		std::vector<bool> _isMissileActive;
+		std::vector<bool> _isTargetAlive;
+		std::vector<Vec2d> _missileStartPositions;	// положения на начало шага - для наибольшего сближения на шаге
+		std::vector<Vec2d> _targetStartPositions;
+		std::vector<Vec2d> _targetEndPositions;
+		std::vector<Vec2d> _targetVelocities;
+		std::vector<double> _lockLostTimes;			// момент последнего срыва захвата, -inf - захват не срывался
+		std::vector<std::size_t> _engagementCounts;	// число ракет, наводящихся на цель
+		std::vector<FuzeEvent> _fuzeEvents;
+		UniformGrid _fuzeGrid;
+		SeekerIndex _seekerIndex;
+		std::size_t _activeMissileCount{ 0 };
+		std::size_t _aliveTargetCount{ 0 };
+		double _elapsedTime{ 0 };
+		double _maxTargetStep{ 0 };	// наибольшее перемещение цели за последний шаг
+		std::size_t _targetIndexOf(MovingObject* target) { return static_cast<Target*>(target) - _targets.data(); }
+		void _acquireTargets();
+		bool _isSearching(std::size_t missileIndex);	// ракета без цели, которой разрешено искать новую
+		bool _isBetterCandidate(const SeekerCandidate& candidate, const SeekerCandidate& best);
+		void _loseLock(std::size_t missileIndex);
+		void _checkFuzes(double elapsedTime);
+		void _deactivateMissile(std::size_t missileIndex);
+		void _killTarget(std::size_t targetIndex);
+		void _updateMissileActivity();
+};
+
+#endif // WORLD_HDR_IG
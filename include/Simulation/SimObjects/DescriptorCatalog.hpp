@@ -0,0 +1,35 @@
+#ifndef DESCRIPTOR_CATALOG_HDR_IG
+#define DESCRIPTOR_CATALOG_HDR_IG
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Simulation/SimObjects/Missile.hpp"
+#include "Simulation/SimObjects/Target.hpp"
+
+class DescriptorCatalog // справочник описаний ракет и целей - читается из db/*.lua один раз и после загрузки не меняется, описания разделяются всеми симуляциями
+{
+	public:
+		static constexpr const char* defaultMissileName = "DefaultAAM";
+		static constexpr const char* defaultTargetName = "DefaultTarget";
+		static constexpr const char* missileDescsFileName = "missileDescs.lua";
+		static constexpr const char* targetDescsFileName = "targetDescs.lua";
+
+		static void setDatabaseDir(const std::string& dbDir);	// задаёт каталог db - действует, если вызвана до первого обращения к instance()
+		static const DescriptorCatalog& instance();				// загружает справочник при первом обращении
+		static DescriptorCatalog loadFrom(const std::string& dbDir); // отсутствующие файлы заменяются встроенными описаниями, ошибки разбора - исключение
+
+		std::shared_ptr<const Missile::MissileDesc> getMissileDesc(const std::string& name = defaultMissileName) const;
+		std::shared_ptr<const Target::TargetDesc> getTargetDesc(const std::string& name = defaultTargetName) const;
+		std::vector<std::string> getMissileNames() const;
+		std::vector<std::string> getTargetNames() const;
+
+	private:
+		DescriptorCatalog(); // содержит только встроенные описания по умолчанию
+		std::map<std::string, std::shared_ptr<const Missile::MissileDesc>> _missileDescs;
+		std::map<std::string, std::shared_ptr<const Target::TargetDesc>> _targetDescs;
+		static std::string& _databaseDir();
+};
+
+#endif // DESCRIPTOR_CATALOG_HDR_IG
@@ -0,0 +1,34 @@
+#ifndef KINEMATIC_POOL_HDR_IG
+#define KINEMATIC_POOL_HDR_IG
+
+#include <cstddef>
+#include <vector>
+
+class KinematicStatePool // состояния множества движущихся объектов в виде структуры массивов - каждая величина лежит в своём непрерывном массиве
+{
+	public:
+		enum Column : std::size_t // номера столбцов состояния
+		{
+			XColumn,
+			YColumn,
+			VelXColumn,
+			VelYColumn,
+			AccXColumn,
+			AccYColumn,
+			ColumnCount
+		};
+		std::size_t add(double x, double y, double velX, double velY, double accX = 0, double accY = 0); // добавляет объект и возвращает его номер
+		std::size_t size() const { return _columns[XColumn].size(); }
+		void reserve(std::size_t capacity);
+		void clear();
+		void advance(double elapsedTime);	// перемещает все объекты с учётом их скорости и ускорения
+		void rotate(const double* angles);	// поворачивает скорость и ускорение каждого объекта на свой угол (рад)
+		double getSpeed(std::size_t index) const;
+		template <Column column> double* data() { return _columns[column].data(); }
+		template <Column column> const double* data() const { return _columns[column].data(); }
+
+	private:
+		std::vector<double> _columns[ColumnCount];
+};
+
+#endif // KINEMATIC_POOL_HDR_IG
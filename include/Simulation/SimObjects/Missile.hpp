@@ -2,8 +2,12 @@
 #define MISSILE_HDR_IG
 
 #include "Simulation/CommonSimParams.hpp"
+#include "Simulation/Auxilary/UniformLookupTable.hpp"
 #include "MovingObject.hpp"
 
+#include <array>
+#include <memory>
+
 class PIDController;
 
 class Missile : public MovingObject // класс ракет
@@ -20,36 +24,54 @@ class Missile : public MovingObject // класс ракет
 			double DyPerDa						= 1.5;	// отвал поляры
 			double proxyFuzeRadius				= 15;	// радиус поражения цели (срабатывания НВ)
 			double seekerMaxOBA					= 15;	// ширина ПЗ ГСН в одну сторону
+			double seekerRange					= 15000;	// дальность захвата цели ГСН
 			double navConstant					= 1.5;	// постоянная наведения
 			double apDelay						= 0.5;	// задержка вкл. автопилота
-			QMap<QString, double> cXData {{"0.5", 0.012}, {"0.9", 0.015}, {"1.2", 0.046}, {"1.5", 0.044}, {"2.0", 0.038}, {"3.0", 0.030}, {"4.0", 0.026}};
+			std::vector<std::pair<double, double>> cXData {{0.5, 0.012}, {0.9, 0.015}, {1.2, 0.046}, {1.5, 0.044}, {2.0, 0.038}, {3.0, 0.030}, {4.0, 0.026}}; // узлы Cx0(M)
+			UniformLookupTable cXTable{ buildZeroLiftDragTable(cXData) };	// Cx0(M), пересчитанный на равномерную сетку
+
+			static UniformLookupTable buildZeroLiftDragTable(const std::vector<std::pair<double, double>>& cXData);
 		};
-		Missile(double initialSpeed, double initialX, double initialY);
+		using State = std::array<double, 5>; // x, y, vx, vy, масса топлива - переменные состояния для интеграторов высокого порядка
+		Missile(double initialSpeed, double initialX, double initialY, std::shared_ptr<const MissileDesc> desc = nullptr); // без описания берётся ракета по умолчанию из справочника
 		double getRemainingFuelMass() { return _remainingFuelMass; };
-		const double getProxyRadius() { return _leDesc.proxyFuzeRadius; };
+		double getTimeToNextEvent();	// время до ближайшего разрыва в правых частях - включения автопилота или выгорания топлива
+		State getDerivative(const State& state, double targetX, double targetY);
+		State getState() { return { _coordinates.x(), _coordinates.y(), _velocity().x(), _velocity().y(), _remainingFuelMass }; };
+		const MissileDesc& getDesc() { return *_leDesc; };
+		const double getProxyRadius() { return _leDesc->proxyFuzeRadius; };
 		MovingObject* getTarget() { return _acquiredTarget; };
 		void advancedMove(double elapsedTime);
 		void basicMove(double elapsedTime, double angleOfAttack);
 		void setTarget(MovingObject* newTarget) { _acquiredTarget = newTarget; };
 		void setNavConstant(double mslNavConstant) { _navConstant = mslNavConstant; };
-		virtual void restore() { _remainingFuelMass = _leDesc.motorFuelMass; };
+		void setState(const State& state, double elapsedTime);	// принимает состояние после шага интегратора длиной elapsedTime
+		void updateSeekerLock();								// срывает захват, если цель вышла из ПЗ ГСН - проверяется на границах шагов
+		virtual void restore() { _remainingFuelMass = _leDesc->motorFuelMass; };
 
 	private:
-		const MissileDesc _leDesc;
+		friend struct MissileBenchAccess; // замеры вызывают закрытые расчётные методы напрямую
+		const std::shared_ptr<const MissileDesc> _leDesc; // описание разделяется всеми ракетами одного типа
 		PIDController* _guidanceComputer{ nullptr };
 		MovingObject* _acquiredTarget{ nullptr };
-		double _navConstant{ _leDesc.navConstant };
-		const double _fuelConsumptionRate{ _leDesc.motorFuelMass / _leDesc.motorBurnTime };
-		const double _engineThrust{ _leDesc.motorSpecImpulse * _fuelConsumptionRate * FREEFALL_ACC };
-		double _remainingFuelMass{ _leDesc.motorFuelMass };
-		double _calculateDynPressure() { return (AIR_DENSITY * pow(getSpeed(), 2) * _leDesc.planformArea) / 2; };						// вычисляет скоростной напор - 0.5 * rho * v ^ 2 * S
-		double _calculateAngleOfAttack(double inducedDragCoeff) { return inducedDragCoeff / _leDesc.DyPerDa; };							// вычисляет угол атаки по коэфф. индуктивного сопротивления
-		double _calculateDragDecelerationRate(double angleOfAttack);																	// вычисляет "замедление", вызванное сопротивлением воздуха
-		double _calculateLiftInducedDragCoefficient(double angleOfAttack) { return angleOfAttack * _leDesc.DyPerDa; };					// вычисляет коэфф. индуктивного сопротивления по углу атаки
-		double _calculateMachNumber(double c) { return getSpeed() / c; };																// вычисляет число Маха
-		double _calculatePropulsionAccelerationRate() { return _remainingFuelMass > 0 ? _engineThrust / _calculateTotalMass() : 0; };	// вычисляет ускорение, вызванное тягой двигателя
-		double _calculateTotalMass() { return _remainingFuelMass + _leDesc.emptyMass; };												// вычисляет полную массу ракеты
-		double _interpolateZeroLiftDragCoefficient(double machNumber);																	// вычисляет коэфф. сопротивления формы по числу Маха
+		double _navConstant{ _leDesc->navConstant };
+		const double _fuelConsumptionRate{ _leDesc->motorFuelMass / _leDesc->motorBurnTime };
+		const double _engineThrust{ _leDesc->motorSpecImpulse * _fuelConsumptionRate * FREEFALL_ACC };
+		double _remainingFuelMass{ _leDesc->motorFuelMass };
+		bool _isGuidanceActive() { return _acquiredTarget && _timeSinceBirth >= _leDesc->apDelay; };											// наводится ли ракета на цель
+		double _calculateDynPressure() { return _calculateDynPressure(getSpeed()); };
+		double _calculateDynPressure(double speed) { return (AIR_DENSITY * pow(speed, 2) * _leDesc->planformArea) / 2; };						// вычисляет скоростной напор - 0.5 * rho * v ^ 2 * S
+		double _calculateAngleOfAttack(double inducedDragCoeff) { return inducedDragCoeff / _leDesc->DyPerDa; };							// вычисляет угол атаки по коэфф. индуктивного сопротивления
+		double _calculateDragDecelerationRate(double angleOfAttack) { return _calculateDragDecelerationRate(angleOfAttack, getSpeed(), _remainingFuelMass); };
+		double _calculateDragDecelerationRate(double angleOfAttack, double speed, double fuelMass);										// вычисляет "замедление", вызванное сопротивлением воздуха
+		double _calculateLiftInducedDragCoefficient(double angleOfAttack) { return angleOfAttack * _leDesc->DyPerDa; };					// вычисляет коэфф. индуктивного сопротивления по углу атаки
+		double _calculateMachNumber(double speed, double c) { return speed / c; };														// вычисляет число Маха
+		double _calculatePropulsionAccelerationRate() { return _calculatePropulsionAccelerationRate(_remainingFuelMass); };
+		double _calculatePropulsionAccelerationRate(double fuelMass) { return fuelMass > 0 ? _engineThrust / _calculateTotalMass(fuelMass) : 0; };	// вычисляет ускорение, вызванное тягой двигателя
+		double _calculateSteeringAngle(double velLOSAngle);																				// вычисляет угол доворота за такт SIM_RESOLUTION по углу между скоростью и линией визирования
+		double _calculateTotalMass() { return _calculateTotalMass(_remainingFuelMass); };
+		double _calculateTotalMass(double fuelMass) { return fuelMass + _leDesc->emptyMass; };											// вычисляет полную массу ракеты
+		double _interpolateZeroLiftDragCoefficient(double machNumber) { return _leDesc->cXTable(machNumber); };							// вычисляет коэфф. сопротивления формы по числу Маха
 		void _setGuidanceBoundary();																									// задаёт пределы углов наведения, выдаваемых регулятором наведения
 };
 
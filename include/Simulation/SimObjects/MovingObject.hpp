@@ -1,43 +1,44 @@
 #ifndef MOVOBJ_HDR_IG
 #define MOVOBJ_HDR_IG
 
-#include <QMap>
-#include <QString>
-#include <QVector2D>
-#include <QPointF>
-#include <random>
+#include "Simulation/Auxilary/CounterRng.hpp"
+#include "Simulation/Auxilary/VecMath.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
 
 class MovingObject // базовый класс движущихся объектов - имеет только скорость и направление движения
 {
 	public:
 		MovingObject() = delete;
 		MovingObject(double initialSpeed, double initialX, double initialY);
-		double getSpeed() { return _actingVectors.at("velocity").length(); }
+		double getSpeed() { return _velocity().length(); }
 		double getX() { return _coordinates.x(); }
 		double getY() { return _coordinates.y(); }
-		const QVector2D& getCoordinates() { return _coordinates; }
-		const QVector2D& getVelocity() { return _actingVectors.at("velocity"); }
-		void setVelocity(const QVector2D& newVel)
-		{
-			auto& velVec = _actingVectors.at("velocity");
-			velVec.setX(newVel.x());
-			velVec.setY(newVel.y());
-		}
-		void setVelocity(float xVel, float yVel)
-		{
-			auto& velVec = _actingVectors.at("velocity");
-			velVec.setX(xVel);
-			velVec.setY(yVel);
-		}
-		void setCoords(float x, float y) { _coordinates = QVector2D(x, y); }
-		void setX(const float x) { _coordinates.setX(x); }
-		void setY(const float y) { _coordinates.setY(y); }
+		const Vec2d& getCoordinates() { return _coordinates; }
+		const Vec2d& getVelocity() { return _velocity(); }
+		void setVelocity(const Vec2d& newVel) { _velocity() = newVel; }
+		void setVelocity(double xVel, double yVel) { _velocity() = Vec2d(xVel, yVel); }
+		void setCoords(double x, double y) { _coordinates = Vec2d(x, y); }
+		void setX(const double x) { _coordinates.setX(x); }
+		void setY(const double y) { _coordinates.setY(y); }
+		void reseed(std::uint64_t seed) { _rng.seed(seed); } // задаёт ключ потока ГСЧ для воспроизводимости прогона
 		virtual void restore() = 0;
 
 	protected:
-		std::unordered_map<QString, QVector2D> _actingVectors;
-		QVector2D _coordinates;
-		std::mt19937_64 _leMersenneTwister;
+		enum ActingVectorSlot : std::size_t // номера ячеек действующих на объект векторов
+		{
+			VelocitySlot,
+			AccelerationSlot,
+			ActingVectorSlotCount
+		};
+		std::array<Vec2d, ActingVectorSlotCount> _actingVectors;	// действующие векторы хранятся подряд и адресуются индексом, известным при компиляции
+		std::size_t _usedActingVectorSlots{ AccelerationSlot };			// число задействованных ячеек - у ракеты только скорость
+		Vec2d& _velocity() { return std::get<VelocitySlot>(_actingVectors); }
+		Vec2d& _acceleration() { return std::get<AccelerationSlot>(_actingVectors); }
+		Vec2d _coordinates;
+		CounterRng _rng;	// без reseed - поток с ключом 0, прогон воспроизводим и так
 		double _timeSinceBirth{ 0 };
 		double _getRandomInRange(double minValue, double maxValue);
 		void _rotateActingVectorsRad(double angle); // поворачивает действующие на объект векторы в соответствии с углом, на который поворачивает объект
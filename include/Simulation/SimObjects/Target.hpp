@@ -3,28 +3,43 @@
 
 #include "MovingObject.hpp"
 
+#include <array>
+#include <memory>
+#include <utility>
+
 class Target : public MovingObject // класс целей - дополнительно имеет поперечное ускорение
 {
 	public:
-		Target(double initialSpeed, double initialX, double initialY);
+		struct TargetDesc
+		{
+			std::pair<double, double> evManeuverTimeConstraints{ 0.5, 30. };	// мин/макс время следования с ускорением для цели
+			std::pair<double, double> evManeuverAccelConstraints{ -9., 9. };	// мин/макс поперечное ускорение цели
+		};
+		using State = std::array<double, 4>; // x, y, vx, vy - переменные состояния для интеграторов высокого порядка
+		Target(double initialSpeed, double initialX, double initialY, std::shared_ptr<const TargetDesc> desc = nullptr); // без описания берётся цель по умолчанию из справочника
 		double getAccelerationRate();
+		double getTimeToManeuverChange();	// время до смены ускорения - разрыв в правых частях, на который должен приходиться конец шага
+		State getDerivative(const State& state);
+		State getState() { return { _coordinates.x(), _coordinates.y(), _velocity().x(), _velocity().y() }; };
 		void advancedMove(double elapsedTime);
 		void basicMove(double elapsedTime);
 		void setAccelerationRate(const double newAccelerationRate);
+		void setState(const State& state, double elapsedTime); // принимает состояние после шага интегратора длиной elapsedTime
 		void setEvasiveActionState(const bool newState) { _isEvasiveActionRequired = newState; restore(); };
 		virtual void restore()
 		{
-			auto& accVec = _actingVectors.at("acceleration");
-			accVec.setX(0); accVec.setY(0);
+			_acceleration() = Vec2d(0, 0);
 
 			_setUpAccelerationParameters();
 		};
 
 	private:
+		const std::shared_ptr<const TargetDesc> _leDesc;
 		bool _isEvasiveActionRequired{ true };
 		double _timeSinceAccelerationChange;	// время, прошедшее с момента изменения ускорения
 		double _timeToProceedWithAcceleration;	// временной промежуток для следования с текущим ускорением
-		void _setUpAccelerationParameters();	// задаёт параметры ускорения
+		void _advanceManeuverTimer(double elapsedTime);	// отсчитывает время манёвра и разыгрывает новый по его окончании
+		void _setUpAccelerationParameters();			// задаёт параметры ускорения
 };
 
 #endif // TARGET_HDR_IG
@@ -3,16 +3,31 @@
 
 #include <QMainWindow>
 #include <QTranslator>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QLabel>
 #include <QStringList>
+#include <atomic>
+#include <memory>
 #include <thread>
 #include <cmath>
 
 #include "Simulation/simulation.hpp"
+#include "Simulation/Batch/EnvelopeSweep.hpp"
+#include "Simulation/Auxilary/SegmentedBuffer.hpp"
+#include "Simulation/Auxilary/SpscRingBuffer.hpp"
+#include "Simulation/Auxilary/TrajectoryDecimator.hpp"
+#include "Simulation/Recording/TrajectoryReplay.hpp"
+
+#define REPLOT_INTERVAL_MS 33 // ~30 кадров в секунду
+#define TERMINAL_DETAIL_RADII 20 // ближе скольких радиусов взрывателя к цели траектория не прореживается
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class MainWindow; }
 QT_END_NAMESPACE
 
+class QCPGraph;
+
 class MainWindow : public QMainWindow
 {
 	Q_OBJECT
@@ -26,6 +41,13 @@ class MainWindow : public QMainWindow
 	private slots:
 		void on_startSimBtn_clicked();
 		void on_resetSimBtn_clicked();
+		void on_envelopeBtn_clicked();
+		void onReplotTimerTimeout();
+		void on_openReplayBtn_clicked();
+		void on_playReplayBtn_clicked();
+		void on_replaySlider_valueChanged(int value);
+		void on_replaySpeedSpinBox_valueChanged(double value);
+		void onReplayTimerTimeout();
 
 	protected:
 		void _changeEvent(QEvent* leEvent);
@@ -34,11 +56,54 @@ class MainWindow : public QMainWindow
 		void slotLangChanged(QAction* leAction);
 
 	private:
+		struct TrajectorySample // положения ракеты и цели на одном шаге моделирования
+		{
+			double mslX, mslY, tgtX, tgtY;
+		};
 		Ui::MainWindow* ui;
-		QVector<double> mslX, mslY, tgtX, tgtY, hitRadX, hitRadY;
+		SegmentedBuffer<Vec2d> mslPoints, tgtPoints; // изменяются только в потоке GUI; при росте уже записанные точки не копируются
+		struct ShownTrajectory // что из траектории уже передано в график: на кадре дописываются только новые точки
+		{
+			std::size_t pointCount{ 0 };
+			double pendingX{ 0 }, pendingY{ 0 };	// хвост прореживателя, показанный на прошлом кадре; заменяется на следующем
+			bool hasPending{ false };
+		};
+		ShownTrajectory mslShown, tgtShown;
+		QVector<double> hitRadX, hitRadY;
+		TrajectoryDecimator mslDecimator, tgtDecimator; // прореживают точки по мере поступления, допуск - радиус взрывателя
+		SpscRingBuffer<TrajectorySample> trajectoryChannel{ 1 << 16 }; // поток моделирования пишет, поток GUI забирает пачками при перерисовке
 		void* radiusCurve{ nullptr };
-		bool simFinished{ false };
+		void* envelopeMap{ nullptr };
+		QLabel* runSeedLabel{ nullptr };	// зерно последнего прогона в строке состояния - по нему прогон повторяется
+		std::uint64_t traceDroppedEvents{ 0 };	// события трассы последнего прогона, отброшенные сверх предела на поток
+		std::thread envelopeThread;
+		std::atomic<bool> simFinished{ false };
+		std::atomic<bool> simCancelRequested{ false };
+		std::atomic<double> simProgressTime{ 0 };		// ход моделирования для отображения в GUI
+		std::atomic<double> simProgressDistance{ 0 };
+		std::thread simThread;
+		bool simRunning{ false };		// меняются только в потоке GUI: поток задания запускается, лишь когда ни одно не идёт,
+		bool envelopeRunning{ false };	// и к его std::thread обращаются, только когда задание закончено
+		bool replayPreparing{ false };	// запись перекладывается в архив; моделирование в это время может перезаписать тот же файл
+		std::thread replayPrepThread;
+		QTimer replotTimer;
+		std::unique_ptr<TrajectoryReplay> replay;	// открытая запись; столбцы читаются из отображённого архива
+		std::size_t replayShownCount{ 0 };			// сколько первых записей уже передано в графики
+		QTimer replayTimer;
+		QElapsedTimer replayClock;					// реальное время между кадрами воспроизведения
+		void finishSim(); // останавливает перерисовку по таймеру и дожидается потока моделирования
+		bool isJobRunning() const { return simRunning || envelopeRunning || replayPreparing; }
+		void updateJobButtons(); // запуск моделирования, зоны пуска и открытие записи доступны, только пока ни одно из них не идёт
+		void openReplay(const std::string& archivePath, QString error); // завершает открытие записи после подготовки архива
 		void plot(bool doFilter = false);
+		void drainTrajectoryChannel();
+		void clearTrajectory();
+		void appendTrajectorySample(const TrajectorySample& sample);
+		static void appendGraphData(QCPGraph* graph, const SegmentedBuffer<Vec2d>& points, const TrajectoryDecimator& decimator, ShownTrajectory& shown);
+		void showEnvelope(const EnvelopeResult& result);
+		void showTrajectoryView();
+		void showReplayFrame();
+		void stopReplay();
 		Simulation* _leSim{ nullptr };
 		void _loadLanguage(const QString& langID);
 		void _createLangMenu(void);
@@ -1,25 +1,42 @@
 #ifndef SIMULATION_HDR_IG
 #define SIMULATION_HDR_IG
 
-#include <QDebug>
 #include "Auxilary/utils.hpp"
 #include "Simulation/SimObjects/Target.hpp"
 #include "Simulation/SimObjects/Missile.hpp"
+#include "Simulation/Recording/TrajectoryRecorder.hpp"
+#include "Simulation/Auxilary/Integrators.hpp"
+
+#include <memory>
 
 class Simulation
 {
 	public:
 		Simulation();
-		Simulation(QPointF targetLocation, double targetSpeed, QPointF missileLocation, double missileSpeed, bool fileOutputNeeded);
+		Simulation(Vec2d targetLocation, double targetSpeed, Vec2d missileLocation, double missileSpeed, bool fileOutputNeeded);
 		~Simulation();
-		// проверяет присутствие ракеты в зоне поражения цели
-		bool mslWithinTgtHitRadius() { return _getMslTgtDistance() <= _missile->getProxyRadius(); };
+		// проверяет срабатывание НВ - в том числе между отсчётами, по наибольшему сближению на шаге
+		bool mslWithinTgtHitRadius() { return _fuzeTriggered || _getMslTgtDistance() <= _missile->getProxyRadius(); };
 		// проверяет соотношение скоростей ракеты и цели
 		bool mslSpeedMoreThanTgtSpeed() { return _missile->getRemainingFuelMass() > 0 ? true : _missile->getSpeed() > _target->getSpeed() && _missile->getTarget(); };
 		Missile* getMissile() { return _missile; };
 		Target* getTarget() { return _target; };
+		double getElapsedTime() { return _simElapsedTime; };
+		double getMslTgtDistance() { return _getMslTgtDistance(); };
+		double getMissDistance() { return _missDistance; };		// наименьшее расстояние между ракетой и целью с начала прогона
+		double getMissTime() { return _missTime; };				// момент наименьшего сближения
+		double getFuzeTime() { return _fuzeTime; };				// момент входа цели в зону поражения НВ
+		const IntegrationSettings& getIntegrationSettings() { return _integration; };
+		std::uint64_t getStepCount() { return _stepCount; };			// число принятых шагов интегратора
+		std::uint64_t getRejectedStepCount() { return _rejectedStepCount; };	// число шагов RK45, отброшенных по ошибке
+		double estimateDuration();			// время до перехвата по текущей дальности и скорости сближения, с запасом на торможение ракеты
+		std::size_t estimateStepCount();	// число шагов за estimateDuration()
 		void iterate();
+		void seed(std::uint64_t seed);
 		void setFileOutputNeededTo(const bool newVal);
+		void startFileOutput();		// новая запись с начала файла для очередного прогона, если вывод в файл нужен
+		void finishFileOutput(TrajectoryFormat::CloseState closeState = TrajectoryFormat::CloseState::Normal);	// дописывает и закрывает запись прогона
+		void setIntegrationSettings(const IntegrationSettings& newSettings) { _integration = newSettings; _adaptiveStep = newSettings.fixedStep; };
 		const double getMslProxyRadius() { return _missile->getProxyRadius(); };
 		void restoreSimState()
 		{
@@ -27,16 +44,39 @@ class Simulation
 			if (_target) _target->restore();
 			if (_target && _missile) _missile->setTarget(_target);
 			_simElapsedTime = 0.;
+			_adaptiveStep = _integration.fixedStep;
+			_stepCount = 0;
+			_rejectedStepCount = 0;
+			_fuzeTriggered = false;
+			_fuzeTime = 0.;
+			_missDistance = _target && _missile ? _getMslTgtDistance() : 0.;
+			_missTime = 0.;
 		};
 
 	private:
+		using EngagementState = Integrators::Vector<9>; // состояние ракеты (5) и цели (4) интегрируется совместно
 		bool _fileOutputNeeded{ false };
+		bool _fuzeTriggered{ false };
+		double _fuzeTime{ 0. };
+		double _missDistance{ 0. };
+		double _missTime{ 0. };
+		IntegrationSettings _integration;
+		double _adaptiveStep{ SIM_RESOLUTION };	// шаг RK45, предложенный по ошибке предыдущего шага
+		std::uint64_t _stepCount{ 0 };
+		std::uint64_t _rejectedStepCount{ 0 };
+		EngagementState _getEngagementState();
+		EngagementState _getEngagementDerivative(const EngagementState& state);
+		double _limitStep(double step);	// укорачивает шаг до ближайшего разрыва
+		void _checkEndgame(const Vec2d& startRelPosition, double startTime);	// находит наибольшее сближение на шаге и проверяет срабатывание НВ
+		void _advanceEuler();
+		void _advanceRungeKutta();
 		double _getMslTgtDistance() { return (_target->getCoordinates() - _missile->getCoordinates()).length(); };
 		double _simElapsedTime{ 0. };
 		Missile* _missile{ nullptr };
-		ofstream _outputFile;
+		std::unique_ptr<TrajectoryRecorder> _recorder;
 		Target* _target{ nullptr };
 		void _prepOutputFile();
+		void _recordState();
 };
 
 #endif // SIMULATION_HDR_IG
@@ -105,5 +105,130 @@
         <source>Simulation&apos;s been stopped: the missile&apos;s velocity has fallen below the target&apos;s</source>
         <translation>Моделирование завершено: скорость ракеты упала ниже скорости цели</translation>
     </message>
+    <message>
+        <location filename="../qml/mainwindow.ui" line="304"/>
+        <source>Launch Envelope</source>
+        <translation>Зона пуска</translation>
+    </message>
+    <message>
+        <location filename="../qml/mainwindow.ui" line="301"/>
+        <source>Sweep target and missile speeds around the current values and plot the maximum launch range</source>
+        <translation>Перебрать скорости цели и ракеты вокруг заданных значений и построить максимальную дальность пуска</translation>
+    </message>
+    <message>
+        <location filename="../source/Simulation/mainwindow.cpp" line="166"/>
+        <source>Computing the launch envelope; please wait</source>
+        <translation>Построение зоны пуска; пожалуйста, подождите</translation>
+    </message>
+    <message>
+        <location filename="../source/Simulation/mainwindow.cpp" line="196"/>
+        <source>Target Speed (m/s)</source>
+        <translation>Скорость цели (м/с)</translation>
+    </message>
+    <message>
+        <location filename="../source/Simulation/mainwindow.cpp" line="197"/>
+        <source>Missile Initial Velocity (m/s)</source>
+        <translation>Начальная скорость ракеты (м/с)</translation>
+    </message>
+    <message>
+        <location filename="../source/Simulation/mainwindow.cpp" line="201"/>
+        <source>Launch envelope: Rmax from %1 to %2 m over %3 engagements</source>
+        <translation>Зона пуска: Rmax от %1 до %2 м по %3 прогонам</translation>
+    </message>
+    <message>
+        <location filename="../source/Simulation/mainwindow.cpp" line="113"/>
+        <source>Simulation&apos;s running: %1 s elapsed, %2 m to the target</source>
+        <translation>Моделирование в процессе: прошло %1 с, до цели %2 м</translation>
+    </message>
+    <message>
+        <location filename="../qml/mainwindow.ui" line="315"/>
+        <source>Replay</source>
+        <translation>Воспроизведение</translation>
+    </message>
+    <message>
+        <location filename="../qml/mainwindow.ui" line="327"/>
+        <source>Recorded Engagement Replay</source>
+        <translation>Воспроизведение записанного перехвата</translation>
+    </message>
+    <message>
+        <location filename="../qml/mainwindow.ui" line="333"/>
+        <source>Open a trajectory recording (.mgtr) or archive (.mgta)</source>
+        <translation>Открыть запись траектории (.mgtr) или архив (.mgta)</translation>
+    </message>
+    <message>
+        <location filename="../qml/mainwindow.ui" line="336"/>
+        <source>Open Recording...</source>
+        <translation>Открыть запись...</translation>
+    </message>
+    <message>
+        <location filename="../qml/mainwindow.ui" line="346"/>
+        <source>Play</source>
+        <translation>Воспроизвести</translation>
+    </message>
+    <message>
+        <location filename="../qml/mainwindow.ui" line="366"/>
+        <source>Playback speed relative to the simulated time</source>
+        <translation>Скорость воспроизведения относительно модельного времени</translation>
+    </message>
+    <message>
+        <location filename="../source/Simulation/mainwindow.cpp" line="252"/>
+        <source>Open Recording</source>
+        <translation>Открыть запись</translation>
+    </message>
+    <message>
+        <location filename="../source/Simulation/mainwindow.cpp" line="252"/>
+        <source>Trajectory recordings (*.mgtr *.mgta)</source>
+        <translation>Записи траекторий (*.mgtr *.mgta)</translation>
+    </message>
+    <message>
+        <location filename="../source/Simulation/mainwindow.cpp" line="352"/>
+        <source>Preparing the recording; please wait</source>
+        <translation>Подготовка записи; пожалуйста, подождите</translation>
+    </message>
+    <message>
+        <location filename="../source/Simulation/mainwindow.cpp" line="265"/>
+        <source>Cannot open the recording: %1</source>
+        <translation>Не удалось открыть запись: %1</translation>
+    </message>
+    <message>
+        <location filename="../source/Simulation/mainwindow.cpp" line="307"/>
+        <source>Pause</source>
+        <translation>Пауза</translation>
+    </message>
+    <message>
+        <location filename="../source/Simulation/mainwindow.cpp" line="370"/>
+        <source>Replay: %1 s of %2 s, %3 m to the target</source>
+        <translation>Воспроизведение: %1 с из %2 с, до цели %3 м</translation>
+    </message>
+    <message>
+        <location filename="../source/Simulation/mainwindow.cpp" line="169"/>
+        <source>Trajectory buffers: %1 + %2 points, %3 segments reserved, %4 grown during the run</source>
+        <translation>Буферы траектории: %1 + %2 точек, сегментов выделено заранее %3, добавлено по ходу %4</translation>
+    </message>
+    <message>
+        <location filename="../source/Simulation/mainwindow.cpp" line="183"/>
+        <source>; trace: %1 events dropped over the per-thread limit</source>
+        <translation>; трасса: %1 событий отброшено сверх предела на поток</translation>
+    </message>
+    <message>
+        <location filename="../qml/mainwindow.ui" line="205"/>
+        <source>Seed</source>
+        <translation>Зерно</translation>
+    </message>
+    <message>
+        <location filename="../qml/mainwindow.ui" line="212"/>
+        <source>Seed of the evasive maneuvers; leave empty to draw a new one for every run</source>
+        <translation>Зерно манёвров уклонения; если поле пусто, для каждого прогона выбирается новое</translation>
+    </message>
+    <message>
+        <location filename="../qml/mainwindow.ui" line="215"/>
+        <source>random</source>
+        <translation>случайное</translation>
+    </message>
+    <message>
+        <location filename="../source/Simulation/mainwindow.cpp" line="135"/>
+        <source>Seed: %1</source>
+        <translation>Зерно: %1</translation>
+    </message>
 </context>
 </TS>
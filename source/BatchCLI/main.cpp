@@ -0,0 +1,396 @@
+#include "Simulation/CommonSimParams.hpp"
+#include "Simulation/Auxilary/CsvWriter.hpp"
+#include "Simulation/Auxilary/PhaseProfiler.hpp"
+#include "Simulation/Auxilary/TraceRecorder.hpp"
+#include "Simulation/Batch/BatchRunner.hpp"
+#include "Simulation/Batch/EnvelopeSweep.hpp"
+#include "Simulation/Recording/TrajectoryArchive.hpp"
+#include "Simulation/Recording/TrajectoryReader.hpp"
+#include "Simulation/Scenario/World.hpp"
+#include "Simulation/SimObjects/DescriptorCatalog.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace
+{
+	void printUsage(const char* programName)
+	{
+		std::cout << "Usage: " << programName << " [options]\n"
+			<< "  --runs N          number of engagements (default 1000)\n"
+			<< "  --seed S          master seed of the batch (default 1)\n"
+			<< "  --threads T       worker threads, 0 = all cores (default 0)\n"
+			<< "  --distance M      initial target distance, m\n"
+			<< "  --tgt-speed V     target speed, m/s\n"
+			<< "  --msl-speed V     missile launch speed, m/s\n"
+			<< "  --nav-const K     missile navigation constant\n"
+			<< "  --max-time T      flight time limit, s\n"
+			<< "  --no-evasion      target flies straight\n"
+			<< "  --integrator M    euler (default), rk4 or rk45\n"
+			<< "  --step H          rk4 step / rk45 initial step, s\n"
+			<< "  --tolerance E     rk45 local error tolerance (default 1e-6)\n"
+			<< "  --lockstep        advance euler engagements in SIMD lockstep batches\n"
+			<< "  --salvo N --raid M  fire N missiles at M targets in one scenario instead of a batch\n"
+			<< "  --spacing D       lateral spacing of launchers and targets in a salvo, m (default 200)\n"
+			<< "  --no-broadphase   check every missile-target pair in a salvo (for comparison)\n"
+			<< "  --selection P     salvo target selection: nearest (default), boresight, closing or least-engaged\n"
+			<< "  --no-reacquire    a salvo missile that lost its target flies on unguided\n"
+			<< "  --reacquire-delay T  time before a salvo missile searches for a new target, s (default 0)\n"
+			<< "  --envelope        compute the launch envelope (min/max launch range) over the speed and nav-constant grid\n"
+			<< "  --tgt-speeds A:B:N  envelope target speeds: N values evenly spaced from A to B or a single value A, m/s (default 200)\n"
+			<< "  --msl-speeds A:B:N  envelope missile launch speeds, same syntax, m/s (default 200)\n"
+			<< "  --nav-consts A:B:N  envelope navigation constants, same syntax (default 1.5)\n"
+			<< "  --range-tolerance D  accuracy of the envelope range bounds, m (default 100)\n"
+			<< "  --db DIR          descriptor database directory (default: db next to the executable)\n"
+			<< "  --results FILE    dump per-engagement results as CSV\n"
+			<< "  --convert TRAJ [CSV]  convert a trajectory recording (.mgtr) into CSV (default: next to it with .csv)\n"
+			<< "  --archive TRAJ [OUT]  convert a trajectory recording into a memory-mapped columnar archive (.mgta)\n"
+			<< "  --window ARCHIVE T0 T1  print the archived records with time in [T0, T1] as CSV\n"
+			<< "  --trace-max-events N  trace events kept per thread, the rest are only counted (MGE_ENABLE_TRACE builds)\n";
+	}
+
+	std::vector<double> parseAxis(const char* spec) // A:B:N -> N равноотстоящих значений от A до B
+	{
+		char* end = nullptr;
+		double first = std::strtod(spec, &end);
+		double last = *end == ':' ? std::strtod(end + 1, &end) : first;
+		std::size_t count = *end == ':' ? std::strtoull(end + 1, &end, 10) : 1;
+
+		return EnvelopeGrid::linspace(first, last, std::max<std::size_t>(count, 1));
+	}
+
+	void printArchiveWindow(const TrajectoryArchive& archive, double startTime, double endTime) // окно читается прямо из отображённых столбцов
+	{
+		auto window = archive.findWindow(startTime, endTime);
+		CsvWriter csv(std::cout);
+
+		archive.prefetch(window);
+
+		for (const auto& name : archive.getColumnNames())
+			csv.writeField(name);
+
+		csv.endRecord();
+
+		for (auto record = window.first; record < window.last; ++record)
+		{
+			for (std::size_t column = 0; column < archive.getColumnCount(); ++column)
+				csv.writeField(archive.getValue(column, record), 5);
+
+			csv.endRecord();
+		}
+	}
+
+	void printEnvelope(const EnvelopeResult& result)
+	{
+		std::cout << "Target Speed (m/s);Missile Speed (m/s);Navigation Constant;Rmin (m);Rmax (m);Rne (m);Runs;\n";
+
+		for (const auto& cell : result.cells)
+		{
+			std::cout << cell.targetSpeed << ";" << cell.missileSpeed << ";" << cell.navConstant << ";"
+				<< cell.rMin << ";" << cell.rMax << ";" << cell.rNoEscape << ";" << cell.runCount << ";\n";
+		}
+	}
+
+	int runSalvo(const EngagementSetup& setup, std::size_t missileCount, std::size_t targetCount, double spacing, std::uint64_t seed, const WorldSettings& settings)
+	{
+		World world(missileCount, targetCount, settings);
+
+		for (std::size_t i = 0; i < targetCount; ++i)
+		{
+			world.addTarget(setup.targetSpeed, (i - 0.5 * (targetCount - 1)) * spacing, setup.targetDistance);
+			world.getTarget(i).setEvasiveActionState(setup.evasiveTarget);
+		}
+
+		for (std::size_t i = 0; i < missileCount; ++i)
+		{
+			world.addMissile(setup.missileSpeed, (i - 0.5 * (missileCount - 1)) * spacing, 0);
+			world.getMissile(i).setNavConstant(setup.navConstant);
+			world.assignTarget(i, i % targetCount); // цели распределяются по кругу, дальше ракеты захватывают их сами
+		}
+
+		world.seed(seed);
+
+		auto startTime = std::chrono::steady_clock::now();
+		std::uint64_t stepCount = 0;
+
+		while (!world.isFinished())
+		{
+			world.iterate();
+			stepCount++;
+		}
+
+		std::chrono::duration<double> wallTime = std::chrono::steady_clock::now() - startTime;
+
+		std::cout << std::fixed << std::setprecision(3)
+			<< "Salvo: " << missileCount << " missiles vs " << targetCount << " targets, " << stepCount << " steps in " << wallTime.count() << " s\n"
+			<< "Targets destroyed: " << world.getFuzeEvents().size() << "  remaining: " << world.getAliveTargetCount() << "  simulated time: " << world.getElapsedTime() << " s\n";
+
+		for (const auto& event : world.getFuzeEvents())
+			std::cout << "  missile " << event.missileIndex << " -> target " << event.targetIndex << " at " << event.time << " s, miss " << event.missDistance << " m\n";
+
+		return EXIT_SUCCESS;
+	}
+
+	void printDistribution(const char* name, const DistributionSummary& summary)
+	{
+		std::cout << name << " (n = " << summary.count << ")\n";
+
+		if (!summary.count)
+			return;
+
+		std::cout << "  min " << summary.min << "  mean " << summary.mean << "  std " << summary.stdDev << "  max " << summary.max << "\n"
+			<< "  p50 " << summary.p50 << "  p90 " << summary.p90 << "  p99 " << summary.p99 << "\n";
+
+		for (std::size_t i = 0; i < summary.histogram.size(); ++i)
+		{
+			std::cout << "  [" << std::setw(12) << summary.histogramMin + i * summary.histogramBinWidth << "; "
+				<< std::setw(12) << summary.histogramMin + (i + 1) * summary.histogramBinWidth << ") " << summary.histogram[i] << "\n";
+		}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+#ifdef MGE_PROFILER
+	// сводка по фазам печатается при любом выходе из main, после того как все рабочие потоки завершились
+	struct ProfileReport { ~ProfileReport() { PhaseProfiler::report(std::cerr); } } profileReport;
+#endif
+#ifdef MGE_TRACE
+	// трасса сохраняется так же - при любом выходе, рядом с остальными результатами прогона
+	struct TraceSaver
+	{
+		~TraceSaver()
+		{
+			if (!TraceRecorder::saveChromeTrace(TRACE_FILE_NAME))
+				std::cerr << "Cannot write " << TRACE_FILE_NAME << "\n";
+
+			if (auto droppedCount = TraceRecorder::getDroppedEventCount())
+				std::cerr << "Trace: " << droppedCount << " events dropped over " << TraceRecorder::maxEventsPerThread.load() << " per thread; raise --trace-max-events\n";
+		}
+	} traceSaver;
+	MGE_TRACE_THREAD_NAME("main");
+#endif
+	EngagementSetup setup;
+	std::size_t runs = 1000;
+	std::uint64_t seed = 1;
+	unsigned threads = 0;
+	std::string resultsPath;
+	bool envelopeMode = false;
+	bool isLockstepEnabled = false;
+	std::size_t salvoSize = 0;
+	std::size_t raidSize = 1;
+	double salvoSpacing = 200;
+	WorldSettings worldSettings;
+	EnvelopeGrid grid;
+	std::string dbDir = (std::filesystem::path(argv[0]).parent_path() / "db").string();
+
+	for (int i = 1; i < argc; ++i)
+	{
+		auto arg = argv[i];
+		auto nextValue = [&]() -> const char*
+		{
+			if (i + 1 >= argc)
+			{
+				std::cerr << "Missing value for " << arg << "\n";
+				std::exit(EXIT_FAILURE);
+			}
+
+			return argv[++i];
+		};
+
+		if (!strcmp(arg, "--runs")) runs = std::strtoull(nextValue(), nullptr, 10);
+		else if (!strcmp(arg, "--seed")) seed = std::strtoull(nextValue(), nullptr, 10);
+		else if (!strcmp(arg, "--threads")) threads = unsigned(std::strtoul(nextValue(), nullptr, 10));
+		else if (!strcmp(arg, "--distance")) setup.targetDistance = std::strtod(nextValue(), nullptr);
+		else if (!strcmp(arg, "--tgt-speed")) setup.targetSpeed = std::strtod(nextValue(), nullptr);
+		else if (!strcmp(arg, "--msl-speed")) setup.missileSpeed = std::strtod(nextValue(), nullptr);
+		else if (!strcmp(arg, "--nav-const")) setup.navConstant = std::strtod(nextValue(), nullptr);
+		else if (!strcmp(arg, "--max-time")) setup.maxFlightTime = std::strtod(nextValue(), nullptr);
+		else if (!strcmp(arg, "--no-evasion")) setup.evasiveTarget = false;
+		else if (!strcmp(arg, "--integrator"))
+		{
+			auto method = nextValue();
+
+			if (!strcmp(method, "euler")) setup.integration.method = IntegrationMethod::Euler;
+			else if (!strcmp(method, "rk4")) setup.integration.method = IntegrationMethod::RK4;
+			else if (!strcmp(method, "rk45")) setup.integration.method = IntegrationMethod::RK45;
+			else
+			{
+				std::cerr << "Unknown integrator: " << method << "\n";
+				return EXIT_FAILURE;
+			}
+		}
+		else if (!strcmp(arg, "--step")) setup.integration.fixedStep = std::strtod(nextValue(), nullptr);
+		else if (!strcmp(arg, "--tolerance")) setup.integration.tolerance = std::strtod(nextValue(), nullptr);
+		else if (!strcmp(arg, "--lockstep")) isLockstepEnabled = true;
+		else if (!strcmp(arg, "--trace-max-events")) TraceRecorder::setMaxEventsPerThread(std::strtoull(nextValue(), nullptr, 10));
+		else if (!strcmp(arg, "--results")) resultsPath = nextValue();
+		else if (!strcmp(arg, "--salvo")) salvoSize = std::strtoull(nextValue(), nullptr, 10);
+		else if (!strcmp(arg, "--raid")) raidSize = std::max<std::size_t>(std::strtoull(nextValue(), nullptr, 10), 1);
+		else if (!strcmp(arg, "--spacing")) salvoSpacing = std::strtod(nextValue(), nullptr);
+		else if (!strcmp(arg, "--no-broadphase")) worldSettings.useBroadphase = false;
+		else if (!strcmp(arg, "--selection"))
+		{
+			auto policy = nextValue();
+
+			if (!strcmp(policy, "nearest")) worldSettings.selectionPolicy = TargetSelectionPolicy::Nearest;
+			else if (!strcmp(policy, "boresight")) worldSettings.selectionPolicy = TargetSelectionPolicy::SmallestOffBoresight;
+			else if (!strcmp(policy, "closing")) worldSettings.selectionPolicy = TargetSelectionPolicy::HighestClosingSpeed;
+			else if (!strcmp(policy, "least-engaged")) worldSettings.selectionPolicy = TargetSelectionPolicy::LeastEngaged;
+			else
+			{
+				std::cerr << "Unknown selection policy: " << policy << "\n";
+				return EXIT_FAILURE;
+			}
+		}
+		else if (!strcmp(arg, "--no-reacquire")) worldSettings.allowReacquisition = false;
+		else if (!strcmp(arg, "--reacquire-delay")) worldSettings.reacquisitionDelay = std::strtod(nextValue(), nullptr);
+		else if (!strcmp(arg, "--db")) dbDir = nextValue();
+		else if (!strcmp(arg, "--convert"))
+		{
+			std::filesystem::path trajectoryPath = nextValue();
+			auto csvPath = i + 1 < argc && strncmp(argv[i + 1], "--", 2) ? std::filesystem::path(argv[++i]) : std::filesystem::path(trajectoryPath).replace_extension(".csv");
+
+			try
+			{
+				convertTrajectoryToCsv(trajectoryPath.string(), csvPath.string());
+			}
+			catch (const std::exception& e)
+			{
+				std::cerr << "Conversion failed: " << e.what() << "\n";
+				return EXIT_FAILURE;
+			}
+
+			return EXIT_SUCCESS;
+		}
+		else if (!strcmp(arg, "--archive"))
+		{
+			std::filesystem::path trajectoryPath = nextValue();
+			auto archivePath = i + 1 < argc && strncmp(argv[i + 1], "--", 2) ? std::filesystem::path(argv[++i]) : std::filesystem::path(trajectoryPath).replace_extension(".mgta");
+
+			try
+			{
+				convertTrajectoryToArchive(trajectoryPath.string(), archivePath.string());
+				std::cout << "Archived " << TrajectoryArchive(archivePath.string()).getRecordCount() << " records to " << archivePath.string() << "\n";
+			}
+			catch (const std::exception& e)
+			{
+				std::cerr << "Archiving failed: " << e.what() << "\n";
+				return EXIT_FAILURE;
+			}
+
+			return EXIT_SUCCESS;
+		}
+		else if (!strcmp(arg, "--window"))
+		{
+			std::string archivePath = nextValue();
+			double startTime = std::strtod(nextValue(), nullptr);
+			double endTime = std::strtod(nextValue(), nullptr);
+
+			try
+			{
+				printArchiveWindow(TrajectoryArchive(archivePath), startTime, endTime);
+			}
+			catch (const std::exception& e)
+			{
+				std::cerr << "Reading the archive failed: " << e.what() << "\n";
+				return EXIT_FAILURE;
+			}
+
+			return EXIT_SUCCESS;
+		}
+		else if (!strcmp(arg, "--envelope")) envelopeMode = true;
+		else if (!strcmp(arg, "--tgt-speeds")) grid.targetSpeeds = parseAxis(nextValue());
+		else if (!strcmp(arg, "--msl-speeds")) grid.missileSpeeds = parseAxis(nextValue());
+		else if (!strcmp(arg, "--nav-consts")) grid.navConstants = parseAxis(nextValue());
+		else if (!strcmp(arg, "--range-tolerance")) grid.distanceTolerance = std::strtod(nextValue(), nullptr);
+		else
+		{
+			printUsage(argv[0]);
+			return strcmp(arg, "--help") ? EXIT_FAILURE : EXIT_SUCCESS;
+		}
+	}
+
+	DescriptorCatalog::setDatabaseDir(dbDir);
+
+	try
+	{
+		DescriptorCatalog::instance();
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "Failed to load the descriptor database: " << e.what() << "\n";
+		return EXIT_FAILURE;
+	}
+
+	if (salvoSize)
+	{
+		worldSettings.maxFlightTime = setup.maxFlightTime;
+
+		return runSalvo(setup, salvoSize, raidSize, salvoSpacing, seed, worldSettings);
+	}
+
+	if (envelopeMode)
+	{
+		grid.masterSeed = seed;
+		grid.maxFlightTime = setup.maxFlightTime;
+		grid.integration = setup.integration;
+
+		auto startTime = std::chrono::steady_clock::now();
+		auto result = EnvelopeSweep(grid, threads).run();
+		std::chrono::duration<double> wallTime = std::chrono::steady_clock::now() - startTime;
+
+		std::cout << std::fixed << std::setprecision(1);
+		printEnvelope(result);
+		std::cerr << result.cells.size() << " cells, " << result.getTotalRunCount() << " engagements in " << wallTime.count() << " s\n";
+
+		return EXIT_SUCCESS;
+	}
+
+	BatchRunner runner(setup, seed, threads);
+
+	runner.setLockstepEnabled(isLockstepEnabled);
+
+	auto startTime = std::chrono::steady_clock::now();
+	auto report = runner.run(runs);
+	std::chrono::duration<double> wallTime = std::chrono::steady_clock::now() - startTime;
+
+	std::cout << std::fixed << std::setprecision(3)
+		<< "Engagements: " << report.engagementCount << " in " << wallTime.count() << " s\n"
+		<< "Hits: " << report.hitCount << "  Pk = " << report.hitProbability << "\n";
+	printDistribution("Miss distance, m", report.missDistance);
+	printDistribution("Time of flight to intercept, s", report.timeOfFlight);
+
+	std::uint64_t totalSteps = 0;
+
+	for (const auto& result : runner.getResults())
+		totalSteps += result.stepCount;
+
+	std::cout << "Integrator steps: " << totalSteps << " (" << (report.engagementCount ? double(totalSteps) / report.engagementCount : 0) << " per engagement)\n";
+
+	if (!resultsPath.empty())
+	{
+		std::ofstream resultsFile(resultsPath, std::ios_base::out | std::ios_base::trunc);
+		resultsFile << "Seed;Hit;Miss Distance (m);Time of Flight (s);Steps;\n";
+		CsvWriter resultsCsv(resultsFile, '.');
+
+		for (const auto& result : runner.getResults())
+		{
+			resultsCsv.writeField(result.seed);
+			resultsCsv.writeField(int(result.hit));
+			resultsCsv.writeField(result.missDistance, 5);
+			resultsCsv.writeField(result.timeOfFlight, 5);
+			resultsCsv.writeField(result.stepCount);
+			resultsCsv.endRecord();
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,40 @@
+#include "Simulation/Auxilary/ClosestApproach.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+ClosestApproach findClosestApproach(double startX, double startY, double endX, double endY)
+{
+	double deltaX = endX - startX, deltaY = endY - startY;
+	double deltaSquared = deltaX * deltaX + deltaY * deltaY;
+	ClosestApproach approach;
+
+	// минимум |r0 + s * d| при s = -(r0, d) / (d, d), ограниченный отрезком
+	if (deltaSquared > 0)
+		approach.fraction = std::clamp(-(startX * deltaX + startY * deltaY) / deltaSquared, 0., 1.);
+
+	approach.distance = std::hypot(startX + approach.fraction * deltaX, startY + approach.fraction * deltaY);
+
+	return approach;
+}
+
+double findSphereEntryFraction(double startX, double startY, double endX, double endY, double radius)
+{
+	double deltaX = endX - startX, deltaY = endY - startY;
+	double a = deltaX * deltaX + deltaY * deltaY;
+	double b = startX * deltaX + startY * deltaY;
+	double c = startX * startX + startY * startY - radius * radius;
+
+	if (c <= 0) // уже внутри сферы в начале шага
+		return 0;
+
+	double discriminant = b * b - a * c;
+
+	if (a == 0 || discriminant < 0)
+		return -1;
+
+	// меньший корень a * s^2 + 2 * b * s + c = 0 - момент входа в сферу
+	double fraction = (-b - std::sqrt(discriminant)) / a;
+
+	return fraction >= 0 && fraction <= 1 ? fraction : -1;
+}
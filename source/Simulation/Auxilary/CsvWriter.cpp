@@ -0,0 +1,67 @@
+#include "Simulation/Auxilary/CsvWriter.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+char* formatFixed(char* first, char* last, double value, int precision, char decimalSeparator)
+{
+	auto [end, error] = std::to_chars(first, last, value, std::chars_format::fixed, precision);
+
+	if (error != std::errc())
+		return first;
+
+	if (decimalSeparator != '.' && precision > 0)
+	{
+		// точка стоит ровно перед дробной частью, искать её не нужно
+		auto point = end - precision - 1;
+
+		if (point >= first && *point == '.')
+			*point = decimalSeparator;
+	}
+
+	return end;
+}
+
+CsvWriter::CsvWriter(std::ostream& output, char decimalSeparator, std::size_t bufferSize) :
+_output(output), _decimalSeparator(decimalSeparator), _buffer(std::max<std::size_t>(bufferSize, 1024)) {}
+
+void CsvWriter::writeField(double value, int precision)
+{
+	const auto maxLength = maxIntegralDigits + std::max(precision, 0) + 3; // знак, точка и ';'
+	auto first = _reserve(maxLength);
+	auto last = formatFixed(first, first + maxLength - 1, value, precision, _decimalSeparator);
+
+	*last++ = CSV_FIELD_SEPARATOR;
+	_size = last - _buffer.data();
+}
+
+void CsvWriter::writeField(std::string_view text)
+{
+	auto first = _reserve(text.size() + 1);
+
+	std::memcpy(first, text.data(), text.size());
+	first[text.size()] = CSV_FIELD_SEPARATOR;
+	_size += text.size() + 1;
+}
+
+void CsvWriter::flush()
+{
+	if (!_size)
+		return;
+
+	_output.write(_buffer.data(), _size);
+	_size = 0;
+}
+
+char* CsvWriter::_reserve(std::size_t count)
+{
+	if (_buffer.size() - _size < count)
+	{
+		flush();
+
+		if (_buffer.size() < count)
+			_buffer.resize(count);
+	}
+
+	return _buffer.data() + _size;
+}
@@ -0,0 +1,302 @@
+#include "Simulation/Auxilary/LuaTableParser.hpp"
+
+#include <cctype>
+#include <charconv>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+	class LuaReader // рекурсивный спуск по подмножеству Lua: присваивания, конструкторы таблиц, числа, строки, true/false/nil
+	{
+		public:
+			explicit LuaReader(const std::string& source) : _source(source) {}
+
+			LuaTable readChunk()
+			{
+				LuaTable globals;
+
+				while (_skipBlanks(), !_atEnd())
+				{
+					auto name = _readName();
+					_expect('=');
+					globals.fields[name] = _readValue();
+					_skipBlanks();
+					_accept(';');
+				}
+
+				return globals;
+			}
+
+		private:
+			const std::string& _source;
+			std::size_t _pos{ 0 };
+			int _line{ 1 };
+
+			bool _atEnd() const { return _pos >= _source.size(); }
+			char _peek() const { return _atEnd() ? '\0' : _source[_pos]; }
+			[[noreturn]] void _fail(const std::string& message) const { throw LuaParseError(message, _line); }
+
+			void _skipBlanks() // пропускает пробельные символы и комментарии, включая --[[ многострочные ]]
+			{
+				while (!_atEnd())
+				{
+					char c = _peek();
+
+					if (c == '\n')
+					{
+						_line++;
+						_pos++;
+					}
+					else if (isspace(static_cast<unsigned char>(c)))
+					{
+						_pos++;
+					}
+					else if (_source.compare(_pos, 4, "--[[") == 0)
+					{
+						auto end = _source.find("]]", _pos + 4);
+						end = end == std::string::npos ? _source.size() : end + 2;
+
+						for (; _pos < end; ++_pos)
+							if (_source[_pos] == '\n') _line++;
+					}
+					else if (_source.compare(_pos, 2, "--") == 0)
+					{
+						while (!_atEnd() && _peek() != '\n')
+							_pos++;
+					}
+					else
+					{
+						break;
+					}
+				}
+			}
+
+			bool _accept(char c)
+			{
+				_skipBlanks();
+
+				if (_peek() != c)
+					return false;
+
+				_pos++;
+
+				return true;
+			}
+
+			void _expect(char c)
+			{
+				if (!_accept(c))
+					_fail(std::string("'") + c + "' expected");
+			}
+
+			bool _nameAhead() const
+			{
+				return isalpha(static_cast<unsigned char>(_peek())) || _peek() == '_';
+			}
+
+			std::string _readName()
+			{
+				_skipBlanks();
+
+				if (!_nameAhead())
+					_fail("identifier expected");
+
+				auto start = _pos;
+
+				while (isalnum(static_cast<unsigned char>(_peek())) || _peek() == '_')
+					_pos++;
+
+				return _source.substr(start, _pos - start);
+			}
+
+			LuaValue _readValue()
+			{
+				LuaValue value;
+
+				_skipBlanks();
+
+				char c = _peek();
+
+				if (c == '{')
+				{
+					value.type = LuaValue::Type::Table;
+					value.table = std::make_shared<const LuaTable>(_readTable());
+				}
+				else if (c == '"' || c == '\'')
+				{
+					value.type = LuaValue::Type::String;
+					value.string = _readString();
+				}
+				else if (c == '-' || c == '.' || isdigit(static_cast<unsigned char>(c)))
+				{
+					value.type = LuaValue::Type::Number;
+					value.number = _readNumber();
+				}
+				else if (_nameAhead())
+				{
+					auto word = _readName();
+
+					if (word == "true" || word == "false")
+					{
+						value.type = LuaValue::Type::Boolean;
+						value.boolean = word == "true";
+					}
+					else if (word != "nil")
+					{
+						_fail("unsupported expression '" + word + "'");
+					}
+				}
+				else
+				{
+					_fail("value expected");
+				}
+
+				return value;
+			}
+
+			LuaTable _readTable()
+			{
+				LuaTable table;
+
+				_expect('{');
+
+				while (!_accept('}'))
+				{
+					if (_atEnd())
+						_fail("unterminated table");
+
+					// поле вида name = value отличаем от позиционного значения, заглядывая за имя
+					auto savedPos = _pos;
+					auto savedLine = _line;
+					bool isNamedField = false;
+
+					if (_nameAhead())
+					{
+						auto name = _readName();
+
+						if (_accept('='))
+						{
+							table.fields[name] = _readValue();
+							isNamedField = true;
+						}
+						else
+						{
+							_pos = savedPos;
+							_line = savedLine;
+						}
+					}
+
+					if (!isNamedField)
+						table.items.push_back(_readValue());
+
+					if (!_accept(',') && !_accept(';'))
+					{
+						_expect('}');
+						break;
+					}
+				}
+
+				return table;
+			}
+
+			std::string _readString()
+			{
+				char quote = _source[_pos++];
+				std::string result;
+
+				while (!_atEnd() && _peek() != quote)
+				{
+					char c = _source[_pos++];
+
+					if (c == '\n')
+						_fail("unterminated string");
+
+					if (c == '\\' && !_atEnd())
+					{
+						c = _source[_pos++];
+						c = c == 'n' ? '\n' : c == 't' ? '\t' : c;
+					}
+
+					result.push_back(c);
+				}
+
+				if (_atEnd())
+					_fail("unterminated string");
+
+				_pos++;
+
+				return result;
+			}
+
+			double _readNumber()
+			{
+				double sign = 1;
+
+				// унарный минус, в том числе с пробелом перед числом
+				while (_peek() == '-')
+				{
+					sign = -sign;
+					_pos++;
+					_skipBlanks();
+				}
+
+				// from_chars не зависит от локали, которую QApplication выставляет процессу
+				const char* start = _source.c_str() + _pos;
+				double number = 0;
+				auto [end, error] = std::from_chars(start, _source.c_str() + _source.size(), number);
+
+				if (error != std::errc())
+					_fail("number expected");
+
+				_pos += end - start;
+
+				return sign * number;
+			}
+	};
+}
+
+const LuaTable* LuaTable::getTable(const std::string& key) const
+{
+	auto field = fields.find(key);
+
+	return field != fields.end() && field->second.type == LuaValue::Type::Table ? field->second.table.get() : nullptr;
+}
+
+double LuaTable::getNumber(const std::string& key, double fallback) const
+{
+	auto field = fields.find(key);
+
+	return field != fields.end() && field->second.type == LuaValue::Type::Number ? field->second.number : fallback;
+}
+
+std::vector<double> LuaTable::getNumbers(const std::string& key) const
+{
+	std::vector<double> numbers;
+
+	if (auto table = getTable(key))
+	{
+		for (const auto& item : table->items)
+			if (item.type == LuaValue::Type::Number) numbers.push_back(item.number);
+	}
+
+	return numbers;
+}
+
+LuaTable parseLuaAssignments(const std::string& source)
+{
+	return LuaReader(source).readChunk();
+}
+
+LuaTable parseLuaAssignmentsFile(const std::string& filePath)
+{
+	std::ifstream file(filePath);
+	std::stringstream contents;
+
+	if (!file.is_open())
+		throw std::runtime_error("cannot open " + filePath);
+
+	contents << file.rdbuf();
+
+	return parseLuaAssignments(contents.str());
+}
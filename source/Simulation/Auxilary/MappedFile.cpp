@@ -0,0 +1,114 @@
+#include "Simulation/Auxilary/MappedFile.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string& filePath)
+{
+	_fileHandle = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+	if (_fileHandle == INVALID_HANDLE_VALUE)
+	{
+		_fileHandle = nullptr;
+		throw std::runtime_error("cannot open " + filePath);
+	}
+
+	LARGE_INTEGER fileSize;
+
+	if (!GetFileSizeEx(_fileHandle, &fileSize))
+	{
+		CloseHandle(_fileHandle);
+		throw std::runtime_error("cannot get the size of " + filePath);
+	}
+
+	_size = static_cast<std::size_t>(fileSize.QuadPart);
+
+	if (!_size) // пустой файл отобразить нельзя
+		return;
+
+	_mappingHandle = CreateFileMappingA(_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	_data = _mappingHandle ? static_cast<const std::uint8_t*>(MapViewOfFile(_mappingHandle, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+
+	if (!_data)
+	{
+		if (_mappingHandle) CloseHandle(_mappingHandle);
+		CloseHandle(_fileHandle);
+		throw std::runtime_error("cannot map " + filePath);
+	}
+}
+
+MappedFile::~MappedFile()
+{
+	if (_data) UnmapViewOfFile(_data);
+	if (_mappingHandle) CloseHandle(_mappingHandle);
+	if (_fileHandle) CloseHandle(_fileHandle);
+}
+
+void MappedFile::prefetch(std::size_t, std::size_t) const {} // PrefetchVirtualMemory есть не во всех поддерживаемых версиях, страницы подгрузятся при обращении
+
+#else
+
+MappedFile::MappedFile(const std::string& filePath)
+{
+	auto descriptor = open(filePath.c_str(), O_RDONLY);
+	struct stat fileStat;
+
+	if (descriptor < 0)
+		throw std::runtime_error("cannot open " + filePath);
+
+	if (fstat(descriptor, &fileStat))
+	{
+		close(descriptor);
+		throw std::runtime_error("cannot get the size of " + filePath);
+	}
+
+	_size = static_cast<std::size_t>(fileStat.st_size);
+
+	if (_size)
+	{
+		auto mapping = mmap(nullptr, _size, PROT_READ, MAP_SHARED, descriptor, 0);
+
+		if (mapping == MAP_FAILED)
+		{
+			close(descriptor);
+			throw std::runtime_error("cannot map " + filePath);
+		}
+
+		_data = static_cast<const std::uint8_t*>(mapping);
+	}
+
+	close(descriptor); // отображение остаётся действительным и после закрытия файла
+}
+
+MappedFile::~MappedFile()
+{
+	if (_data) munmap(const_cast<std::uint8_t*>(_data), _size);
+}
+
+void MappedFile::prefetch(std::size_t offset, std::size_t size) const
+{
+	const std::size_t pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+
+	if (!_data || offset >= _size)
+		return;
+
+	auto first = offset / pageSize * pageSize; // madvise требует выровненного начала
+	auto last = std::min(offset + size, _size);
+
+	madvise(const_cast<std::uint8_t*>(_data) + first, last - first, MADV_WILLNEED);
+}
+
+#endif
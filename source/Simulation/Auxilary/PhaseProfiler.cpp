@@ -0,0 +1,180 @@
+#include "Simulation/Auxilary/PhaseProfiler.hpp"
+
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	using MergedStats = std::array<PhaseProfiler::PhaseStats, std::size_t(PhaseProfiler::Phase::Count)>;
+
+	const char* phaseNames[] = { "Simulation::iterate", "Missile::advancedMove", "Missile::_calculateDragDecelerationRate", "Target::advancedMove",
+		"TrajectoryRecorder::append", "TrajectoryRecorder::_writeBlock", "convertTrajectoryToCsv" };
+
+	static_assert(sizeof(phaseNames) / sizeof(phaseNames[0]) == std::size_t(PhaseProfiler::Phase::Count), "every phase needs a name");
+
+	struct Registry // счётчики всех потоков, когда-либо что-то замерявших
+	{
+		std::mutex lock;
+		std::vector<std::unique_ptr<PhaseProfiler::ThreadStats>> threads;
+		// опорная точка для пересчёта тактов счётчика в наносекунды
+		std::uint64_t startTicks{ PhaseProfiler::readTicks() };
+		std::chrono::steady_clock::time_point startTime{ std::chrono::steady_clock::now() };
+	};
+
+	Registry& getRegistry()
+	{
+		static Registry registry;
+
+		return registry;
+	}
+
+	double getNanosecondsPerTick()
+	{
+		auto& registry = getRegistry();
+		auto elapsedTicks = PhaseProfiler::readTicks() - registry.startTicks;
+		auto elapsedTime = std::chrono::steady_clock::now() - registry.startTime;
+
+		// при слишком коротком интервале оценка неустойчива - добираем его до миллисекунды
+		if (elapsedTime < std::chrono::milliseconds(1))
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			elapsedTicks = PhaseProfiler::readTicks() - registry.startTicks;
+			elapsedTime = std::chrono::steady_clock::now() - registry.startTime;
+		}
+
+		return elapsedTicks ? std::chrono::duration<double, std::nano>(elapsedTime).count() / elapsedTicks : 1;
+	}
+
+	double getHistogramQuantile(const PhaseProfiler::PhaseStats& stats, double quantile) // верхняя граница корзины, в которую попадает квантиль
+	{
+		auto threshold = quantile * stats.count;
+		std::uint64_t accumulated = 0;
+
+		for (std::size_t i = 0; i < stats.histogram.size(); ++i)
+		{
+			accumulated += stats.histogram[i];
+
+			if (accumulated >= threshold)
+				return std::min(PhaseProfiler::getHistogramBucketStart(i + 1), double(stats.maxTicks));
+		}
+
+		return double(stats.maxTicks);
+	}
+}
+
+PhaseProfiler::ThreadStats* PhaseProfiler::getThreadStats()
+{
+	auto& registry = getRegistry();
+	std::lock_guard<std::mutex> guard(registry.lock);
+
+	registry.threads.push_back(std::make_unique<ThreadStats>());
+	registry.threads.back()->epoch.store(resetEpoch.load(std::memory_order_relaxed), std::memory_order_release);
+
+	return registry.threads.back().get();
+}
+
+void PhaseProfiler::startEpoch(ThreadStats& threadStats, std::uint64_t epoch)
+{
+	for (auto& stats : threadStats.phases)
+	{
+		storeOwned(stats.count, 0);
+		storeOwned(stats.totalTicks, 0);
+		storeOwned(stats.minTicks, ~std::uint64_t(0));
+		storeOwned(stats.maxTicks, 0);
+
+		for (auto& bucket : stats.histogram)
+			storeOwned(bucket, 0);
+	}
+
+	// отчёт, увидевший новый номер, видит и обнулённые счётчики
+	threadStats.epoch.store(epoch, std::memory_order_release);
+}
+
+void PhaseProfiler::reset()
+{
+	resetEpoch.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PhaseProfiler::report(std::ostream& output)
+{
+	const auto nsPerTick = getNanosecondsPerTick();
+	const auto epoch = resetEpoch.load(std::memory_order_relaxed);
+	MergedStats merged;
+
+	{
+		auto& registry = getRegistry();
+		std::lock_guard<std::mutex> guard(registry.lock);
+
+		for (const auto& threadStats : registry.threads)
+		{
+			// поток ничего не замерял после сброса - его счётчики относятся к прошлому отчёту
+			if (threadStats->epoch.load(std::memory_order_acquire) != epoch)
+				continue;
+
+			for (std::size_t phase = 0; phase < merged.size(); ++phase)
+			{
+				const auto& source = threadStats->phases[phase];
+				auto& target = merged[phase];
+
+				target.count += loadOwned(source.count);
+				target.totalTicks += loadOwned(source.totalTicks);
+				target.minTicks = std::min(target.minTicks, loadOwned(source.minTicks));
+				target.maxTicks = std::max(target.maxTicks, loadOwned(source.maxTicks));
+
+				for (std::size_t i = 0; i < target.histogram.size(); ++i)
+					target.histogram[i] += loadOwned(source.histogram[i]);
+			}
+		}
+	}
+
+	const auto flags = output.flags();
+	const auto precision = output.precision();
+
+	output << std::fixed << std::setprecision(1) << "Phase profile (inclusive time, quantiles are histogram bucket bounds):\n"
+		<< std::left << std::setw(42) << "  phase" << std::right << std::setw(12) << "calls" << std::setw(12) << "total ms"
+		<< std::setw(10) << "mean ns" << std::setw(10) << "min ns" << std::setw(10) << "p50 ns" << std::setw(10) << "p99 ns" << std::setw(12) << "max ns" << "\n";
+
+	for (std::size_t phase = 0; phase < merged.size(); ++phase)
+	{
+		const auto& stats = merged[phase];
+
+		if (!stats.count)
+			continue;
+
+		output << "  " << std::left << std::setw(40) << phaseNames[phase] << std::right << std::setw(12) << stats.count
+			<< std::setw(12) << stats.totalTicks * nsPerTick / 1e6
+			<< std::setw(10) << stats.totalTicks * nsPerTick / stats.count
+			<< std::setw(10) << stats.minTicks * nsPerTick
+			<< std::setw(10) << getHistogramQuantile(stats, 0.5) * nsPerTick
+			<< std::setw(10) << getHistogramQuantile(stats, 0.99) * nsPerTick
+			<< std::setw(12) << stats.maxTicks * nsPerTick << "\n";
+	}
+
+	// гистограммы: по корзине на строку, пустые корзины по краям опускаются
+	for (std::size_t phase = 0; phase < merged.size(); ++phase)
+	{
+		const auto& stats = merged[phase];
+
+		if (!stats.count)
+			continue;
+
+		output << "  " << phaseNames[phase] << " histogram:\n";
+
+		for (std::size_t i = 0; i < stats.histogram.size(); ++i)
+		{
+			if (!stats.histogram[i])
+				continue;
+
+			output << "    [" << std::setw(10) << getHistogramBucketStart(i) * nsPerTick << "; " << std::setw(10) << getHistogramBucketStart(i + 1) * nsPerTick
+				<< ") ns " << std::setw(12) << stats.histogram[i] << " " << std::string(std::size_t(60. * stats.histogram[i] / stats.count + 0.5), '#') << "\n";
+		}
+	}
+
+	output.flags(flags);
+	output.precision(precision);
+}
@@ -0,0 +1,248 @@
+#include "Simulation/Auxilary/TraceRecorder.hpp"
+#include "Simulation/Auxilary/CsvWriter.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+	struct Registry // буферы потоков, что-то записавших с последнего reset(), и ещё работающих потоков
+	{
+		std::mutex lock;
+		std::vector<std::unique_ptr<TraceRecorder::ThreadBuffer>> threads;
+		std::uint32_t nextThreadId{ 1 };
+		std::uint64_t startNs{ TraceRecorder::getNowNs() };	// начало оси времени в файле
+	};
+
+	Registry& getRegistry()
+	{
+		// не разрушается: отсоединённые потоки могут дописывать события и завершаться уже во время выхода из программы
+		static auto registry = new Registry;
+
+		return *registry;
+	}
+
+	class JsonOutput // накапливает текст и отдаёт его в поток крупными кусками - событий бывают миллионы
+	{
+		public:
+			explicit JsonOutput(std::ostream& output) : _output(output) { _buffer.reserve(bufferSize + maxItemLength); }
+			~JsonOutput() { flush(); }
+
+			JsonOutput& operator<<(std::string_view text)
+			{
+				_buffer.append(text);
+				_flushIfFull();
+
+				return *this;
+			}
+
+			JsonOutput& operator<<(std::uint64_t value)
+			{
+				char digits[24];
+
+				_buffer.append(digits, std::to_chars(digits, digits + sizeof(digits), value).ptr);
+				_flushIfFull();
+
+				return *this;
+			}
+
+			void writeMicroseconds(std::uint64_t nanoseconds) // формат трассы - микросекунды, дробная часть сохраняет наносекунды
+			{
+				char digits[32];
+
+				_buffer.append(digits, formatFixed(digits, digits + sizeof(digits), nanoseconds / 1e3, 3, '.'));
+				_flushIfFull();
+			}
+
+			void writeString(const char* text)
+			{
+				_buffer.push_back('"');
+
+				for (; *text; ++text)
+				{
+					if (*text == '"' || *text == '\\')
+						_buffer.push_back('\\');
+
+					_buffer.push_back(*text);
+				}
+
+				_buffer.push_back('"');
+				_flushIfFull();
+			}
+
+			void flush()
+			{
+				_output.write(_buffer.data(), std::streamsize(_buffer.size()));
+				_buffer.clear();
+			}
+
+		private:
+			static constexpr std::size_t bufferSize{ 1 << 16 };
+			static constexpr std::size_t maxItemLength{ 256 };
+
+			std::ostream& _output;
+			std::string _buffer;
+
+			void _flushIfFull()
+			{
+				if (_buffer.size() >= bufferSize)
+					flush();
+			}
+	};
+}
+
+TraceRecorder::ThreadBuffer::~ThreadBuffer()
+{
+	auto chunk = head.next.load(std::memory_order_relaxed);
+
+	while (chunk)
+	{
+		auto next = chunk->next.load(std::memory_order_relaxed);
+
+		delete chunk;
+		chunk = next;
+	}
+}
+
+void TraceRecorder::ThreadBuffer::startEpoch(std::uint64_t newEpoch)
+{
+	// читатель обходит куски под той же блокировкой - освобождать их можно только под ней
+	std::lock_guard<std::mutex> guard(getRegistry().lock);
+	auto chunk = head.next.load(std::memory_order_relaxed);
+
+	while (chunk)
+	{
+		auto next = chunk->next.load(std::memory_order_relaxed);
+
+		delete chunk;
+		chunk = next;
+	}
+
+	head.next.store(nullptr, std::memory_order_relaxed);
+	tail = &head;
+	publishedCount.store(0, std::memory_order_relaxed);
+	droppedCount.store(0, std::memory_order_relaxed);
+	epoch = newEpoch;
+}
+
+TraceRecorder::ThreadBuffer* TraceRecorder::registerThreadBuffer()
+{
+	auto& registry = getRegistry();
+	std::lock_guard<std::mutex> guard(registry.lock);
+
+	registry.threads.push_back(std::make_unique<ThreadBuffer>());
+	registry.threads.back()->threadId = registry.nextThreadId++;
+	registry.threads.back()->epoch = resetEpoch.load(std::memory_order_relaxed);
+
+	return registry.threads.back().get();
+}
+
+void TraceRecorder::releaseThreadBuffer(ThreadBuffer* threadBuffer)
+{
+	auto& registry = getRegistry();
+	std::lock_guard<std::mutex> guard(registry.lock);
+
+	threadBuffer->isReleased = true;
+}
+
+void TraceRecorder::reset()
+{
+	auto& registry = getRegistry();
+	std::lock_guard<std::mutex> guard(registry.lock);
+
+	// буферы завершившихся потоков больше никто не пополнит - их память освобождается сразу
+	registry.threads.erase(std::remove_if(registry.threads.begin(), registry.threads.end(),
+		[](const std::unique_ptr<ThreadBuffer>& threadBuffer) { return threadBuffer->isReleased; }), registry.threads.end());
+	resetEpoch.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::uint64_t TraceRecorder::getDroppedEventCount()
+{
+	auto& registry = getRegistry();
+	std::lock_guard<std::mutex> guard(registry.lock);
+	const auto currentEpoch = resetEpoch.load(std::memory_order_relaxed);
+	std::uint64_t droppedCount = 0;
+
+	for (const auto& threadBuffer : registry.threads)
+		if (threadBuffer->epoch == currentEpoch)
+			droppedCount += threadBuffer->droppedCount.load(std::memory_order_relaxed);
+
+	return droppedCount;
+}
+
+void TraceRecorder::writeChromeTrace(std::ostream& output)
+{
+	auto& registry = getRegistry();
+
+	// блокировка держится весь вывод: куски при сбросе освобождаются только под ней, сами события дописываются без неё
+	std::lock_guard<std::mutex> guard(registry.lock);
+	const auto currentEpoch = resetEpoch.load(std::memory_order_relaxed);
+	JsonOutput json(output);
+	std::uint64_t droppedCount = 0;
+	bool isFirst = true;
+	auto separate = [&]() { json << (isFirst ? "\n" : ",\n"); isFirst = false; };
+
+	json << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+	for (const auto& threadBuffer : registry.threads)
+	{
+		const auto threadId = std::uint64_t(threadBuffer->threadId);
+
+		// события потока относятся к прошлым прогонам, он ещё ничего не записал после сброса
+		if (threadBuffer->epoch != currentEpoch)
+			continue;
+
+		if (auto name = threadBuffer->name.load(std::memory_order_relaxed))
+		{
+			separate();
+			json << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << threadId << ",\"args\":{\"name\":";
+			json.writeString(name);
+			json << "}}";
+		}
+
+		// опубликованный счётчик читается один раз: события после него могут быть записаны не полностью
+		auto remaining = threadBuffer->publishedCount.load(std::memory_order_acquire);
+
+		droppedCount += threadBuffer->droppedCount.load(std::memory_order_relaxed);
+
+		for (auto chunk = &threadBuffer->head; chunk && remaining; chunk = chunk->next.load(std::memory_order_acquire))
+		{
+			auto count = std::min(remaining, chunkCapacity);
+
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				const auto& event = chunk->events[i];
+
+				separate();
+				json << "{\"name\":";
+				json.writeString(event.name);
+				json << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << threadId << ",\"ts\":";
+				json.writeMicroseconds(event.startNs > registry.startNs ? event.startNs - registry.startNs : 0);
+				json << ",\"dur\":";
+				json.writeMicroseconds(event.durationNs);
+				json << "}";
+			}
+
+			remaining -= count;
+		}
+	}
+
+	json << "\n],\"otherData\":{\"droppedEvents\":" << droppedCount << ",\"maxEventsPerThread\":" << std::uint64_t(maxEventsPerThread.load(std::memory_order_relaxed)) << "}}\n";
+}
+
+bool TraceRecorder::saveChromeTrace(const std::string& filePath)
+{
+	std::ofstream output(filePath, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+
+	if (!output)
+		return false;
+
+	writeChromeTrace(output);
+
+	return bool(output);
+}
@@ -0,0 +1,16 @@
+#include "Simulation/Auxilary/UniformGrid.hpp"
+
+void UniformGrid::rebuild(const std::vector<Vec2d>& positions, const std::vector<bool>& isIncluded, double cellSize)
+{
+	_cellSize = cellSize;
+	_entries.clear();
+
+	for (std::size_t i = 0; i < positions.size(); ++i)
+	{
+		if (isIncluded[i])
+			_entries.push_back({ _keyOf(_cellOf(positions[i].x()), _cellOf(positions[i].y())), i });
+	}
+
+	// внутри ячейки порядок по номеру - обход детерминирован
+	std::sort(_entries.begin(), _entries.end(), [](const Entry& a, const Entry& b) { return a.key != b.key ? a.key < b.key : a.index < b.index; });
+}
@@ -0,0 +1,34 @@
+#include "Simulation/Auxilary/UniformLookupTable.hpp"
+#include "Simulation/Auxilary/utils.hpp"
+
+#include <stdexcept>
+
+UniformLookupTable::UniformLookupTable(std::vector<std::pair<double, double>> knots, double step)
+{
+	if (knots.size() < 2 || step <= 0)
+		throw std::invalid_argument("UniformLookupTable needs at least two knots and a positive step");
+
+	std::sort(knots.begin(), knots.end());
+
+	const double span = knots.back().first - knots.front().first;
+	const auto sampleCount = static_cast<std::size_t>(std::ceil(span / step - 1e-9)) + 1;
+	std::size_t segment = 0;
+
+	_minArg = knots.front().first;
+	_invStep = 1. / step;
+	_lastPosition = double(std::max<std::size_t>(sampleCount, 2) - 1);
+	_values.resize(std::max<std::size_t>(sampleCount, 2));
+
+	// узлы отсортированы, поэтому отрезок для каждой точки сетки ищется одним проходом
+	for (std::size_t i = 0; i < _values.size(); ++i)
+	{
+		double arg = std::min(_minArg + i * step, knots.back().first);
+
+		while (segment + 2 < knots.size() && arg > knots[segment + 1].first)
+			segment++;
+
+		const auto& [prevX, prevY] = knots[segment];
+		const auto& [nextX, nextY] = knots[segment + 1];
+		_values[i] = nextX > prevX ? lerp(arg, prevX, prevY, nextX, nextY) : nextY;
+	}
+}
@@ -0,0 +1,48 @@
+#include "Simulation/Auxilary/VectorRotation.hpp"
+#include "Simulation/Auxilary/SimdMath.hpp"
+
+using SimdMath::ScalarLanes;
+using SimdMath::SimdLanes;
+using SimdMath::computeSinCos;
+
+namespace
+{
+	template <typename Lanes> void rotatePack(typename Lanes::Pack sine, typename Lanes::Pack cosine, double* xs, double* ys)
+	{
+		using L = Lanes;
+		auto x = L::load(xs), y = L::load(ys);
+
+		L::store(xs, L::sub(L::mul(x, cosine), L::mul(y, sine)));
+		L::store(ys, L::add(L::mul(x, sine), L::mul(y, cosine)));
+	}
+
+	template <typename Lanes> std::size_t rotateRange(std::size_t first, const double* angles, double* xs, double* ys, double* secondXs, double* secondYs, std::size_t count)
+	{
+		typename Lanes::Pack sine, cosine;
+		std::size_t i = first;
+
+		for (; i + Lanes::width <= count; i += Lanes::width)
+		{
+			computeSinCos<Lanes>(Lanes::load(angles + i), sine, cosine);
+			rotatePack<Lanes>(sine, cosine, xs + i, ys + i);
+
+			if (secondXs)
+				rotatePack<Lanes>(sine, cosine, secondXs + i, secondYs + i);
+		}
+
+		return i;
+	}
+}
+
+void rotateVectorsBatch(const double* angles, double* xs, double* ys, std::size_t count)
+{
+	rotateVectorsBatch(angles, xs, ys, nullptr, nullptr, count);
+}
+
+void rotateVectorsBatch(const double* angles, double* xs, double* ys, double* secondXs, double* secondYs, std::size_t count)
+{
+	// основная часть - полными SIMD-пакетами, хвост - тем же алгоритмом по одному углу
+	auto processed = rotateRange<SimdLanes>(0, angles, xs, ys, secondXs, secondYs, count);
+
+	rotateRange<ScalarLanes>(processed, angles, xs, ys, secondXs, secondYs, count);
+}
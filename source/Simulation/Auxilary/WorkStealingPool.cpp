@@ -0,0 +1,109 @@
+#include "Simulation/Auxilary/WorkStealingPool.hpp"
+#include "Simulation/Auxilary/TraceRecorder.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <thread>
+
+WorkStealingPool::WorkStealingPool(unsigned threadCount) : _threadCount(threadCount)
+{
+	if (!_threadCount)
+		_threadCount = std::max(1u, std::thread::hardware_concurrency());
+}
+
+void WorkStealingPool::parallelFor(std::size_t taskCount, const std::function<void(std::size_t)>& task)
+{
+	if (!taskCount)
+		return;
+
+	const unsigned workerCount = static_cast<unsigned>(std::min<std::size_t>(_threadCount, taskCount));
+	std::vector<std::unique_ptr<WorkRange>> ranges;
+	std::exception_ptr firstError;
+	std::mutex errorLock;
+
+	// изначально делим задачи поровну между потоками
+	for (unsigned i = 0; i < workerCount; ++i)
+	{
+		auto range = std::make_unique<WorkRange>();
+		range->begin = taskCount * i / workerCount;
+		range->end = taskCount * (i + 1) / workerCount;
+		ranges.push_back(std::move(range));
+	}
+
+	auto worker = [&](unsigned workerIndex)
+	{
+		std::size_t taskIndex;
+
+		while (_popLocal(*ranges[workerIndex], taskIndex) || _steal(ranges, workerIndex, taskIndex))
+		{
+			try
+			{
+				task(taskIndex);
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> guard(errorLock);
+				if (!firstError) firstError = std::current_exception();
+			}
+		}
+	};
+
+	std::vector<std::thread> threads;
+	threads.reserve(workerCount - 1);
+
+	for (unsigned i = 1; i < workerCount; ++i)
+		threads.emplace_back([&worker, i] { MGE_TRACE_THREAD_NAME("WorkStealingPool worker"); worker(i); });
+
+	worker(0); // вызывающий поток тоже участвует в работе
+
+	for (auto& thread : threads)
+		thread.join();
+
+	if (firstError)
+		std::rethrow_exception(firstError);
+}
+
+bool WorkStealingPool::_popLocal(WorkRange& range, std::size_t& taskIndex)
+{
+	std::lock_guard<std::mutex> guard(range.lock);
+
+	if (range.begin >= range.end)
+		return false;
+
+	taskIndex = range.begin++;
+
+	return true;
+}
+
+bool WorkStealingPool::_steal(std::vector<std::unique_ptr<WorkRange>>& ranges, unsigned thiefIndex, std::size_t& taskIndex)
+{
+	const auto rangeCount = ranges.size();
+
+	for (std::size_t offset = 1; offset < rangeCount; ++offset)
+	{
+		auto& victim = *ranges[(thiefIndex + offset) % rangeCount];
+		std::size_t stolenBegin, stolenEnd;
+
+		{
+			std::lock_guard<std::mutex> guard(victim.lock);
+
+			if (victim.begin >= victim.end)
+				continue;
+
+			stolenBegin = victim.begin + (victim.end - victim.begin) / 2;
+			stolenEnd = victim.end;
+			victim.end = stolenBegin;
+		}
+
+		// первую из украденных задач выполняем сразу, остальные кладём в свой диапазон, откуда их смогут украсть другие
+		auto& own = *ranges[thiefIndex];
+		std::lock_guard<std::mutex> guard(own.lock);
+		own.begin = stolenBegin + 1;
+		own.end = stolenEnd;
+		taskIndex = stolenBegin;
+
+		return true;
+	}
+
+	return false;
+}
@@ -1,4 +1,6 @@
 #include "Simulation/Auxilary/utils.hpp"
+#include "Simulation/Auxilary/VectorRotation.hpp"
+#include "Simulation/Auxilary/CsvWriter.hpp"
 
 double degToRad(double degrees)
 {
@@ -10,9 +12,14 @@ double radToDeg(double radians)
 	return radians * 180.0 / M_PI;
 }
 
-double getAngleBetweenVectorsRad(const QVector2D& firstVector, const QVector2D& secondVector)
+double getAngleBetweenVectorsRad(const Vec2d& firstVector, const Vec2d& secondVector)
 {
-	double angle = atan2(secondVector.y(), secondVector.x()) - atan2(firstVector.y(), firstVector.x());
+	return getAngleBetweenVectorsRad(firstVector.x(), firstVector.y(), secondVector.x(), secondVector.y());
+}
+
+double getAngleBetweenVectorsRad(double firstX, double firstY, double secondX, double secondY)
+{
+	double angle = atan2(secondY, secondX) - atan2(firstY, firstX);
 
 	// нормализуем угол в диапазон -pi..pi
 	if (angle > M_PI) angle -= 2 * M_PI;
@@ -21,13 +28,22 @@ double getAngleBetweenVectorsRad(const QVector2D& firstVector, const QVector2D&
 	return angle;
 }
 
-void rotateVec(double angle, QVector2D& vector, const bool isRad)
+void rotateVec(double angle, Vec2d& vector, const bool isRad)
+{
+	rotateVecs(isRad ? angle : degToRad(angle), &vector, 1);
+}
+
+void rotateVecs(double angle, Vec2d* vectors, std::size_t count)
 {
-	QTransform transform = isRad ? QTransform().rotateRadians(angle) : QTransform().rotate(angle);
-	QPointF rotatedPoint = transform.map(vector.toPointF());
+	SinCos sinCos(angle);
 
-	vector.setX(rotatedPoint.x());
-	vector.setY(rotatedPoint.y());
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		double x = vectors[i].x(), y = vectors[i].y();
+
+		sinCos.rotate(x, y);
+		vectors[i] = Vec2d(x, y);
+	}
 }
 
 double lerp(double currX, double prevX, double prevY, double nextX, double nextY)
@@ -37,11 +53,8 @@ double lerp(double currX, double prevX, double prevY, double nextX, double nextY
 
 string convertDoubleToStringWithPrecision(double dbl, int precision, bool changeDecimal)
 {
-	stringstream s;
-
-	if (changeDecimal) s.imbue(locale(locale::classic(), new Comma));
-	s << fixed << setprecision(precision);
-	s << dbl;
+	char buffer[384];
+	auto end = formatFixed(buffer, buffer + sizeof(buffer), dbl, precision, changeDecimal ? ',' : '.');
 
-	return s.str();
+	return string(buffer, end);
 }
@@ -0,0 +1,140 @@
+#include "Simulation/Batch/BatchRunner.hpp"
+#include "Simulation/simulation.hpp"
+#include "Simulation/Auxilary/CounterRng.hpp"
+#include "Simulation/Batch/LockstepBatch.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+BatchRunner::BatchRunner(const EngagementSetup& setup, std::uint64_t masterSeed, unsigned threadCount) :
+_setup(setup), _masterSeed(masterSeed), _pool(threadCount) {}
+
+BatchReport BatchRunner::run(std::size_t engagementCount)
+{
+	BatchReport report;
+	vector<double> missDistances, flightTimes;
+
+	_results.assign(engagementCount, EngagementResult());
+
+	// каждый прогон пишет только в свою ячейку, поэтому синхронизация не требуется
+	if (_isLockstepEnabled && LockstepBatch::isApplicable(_setup))
+		_runLockstep(engagementCount);
+	else
+		_pool.parallelFor(engagementCount, [this](std::size_t i) { _results[i] = runEngagement(_setup, deriveSeed(_masterSeed, i)); });
+
+	missDistances.reserve(engagementCount);
+
+	for (const auto& result : _results)
+	{
+		missDistances.push_back(result.missDistance);
+
+		if (result.hit)
+		{
+			report.hitCount++;
+			flightTimes.push_back(result.timeOfFlight);
+		}
+	}
+
+	report.engagementCount = engagementCount;
+	report.hitProbability = engagementCount ? double(report.hitCount) / engagementCount : 0;
+	report.missDistance = DistributionSummary::fromSamples(std::move(missDistances));
+	report.timeOfFlight = DistributionSummary::fromSamples(std::move(flightTimes));
+
+	return report;
+}
+
+EngagementResult BatchRunner::runEngagement(const EngagementSetup& setup, std::uint64_t seed)
+{
+	Simulation leSim(Vec2d(0, setup.targetDistance), setup.targetSpeed, Vec2d(0, 0), setup.missileSpeed, false);
+	EngagementResult result;
+
+	leSim.getMissile()->setNavConstant(setup.navConstant);
+	leSim.setIntegrationSettings(setup.integration);
+	leSim.seed(seed);
+	leSim.getTarget()->setEvasiveActionState(setup.evasiveTarget); // параметры манёвра разыгрываются уже с новым зерном
+
+	result.seed = seed;
+
+	while (leSim.getElapsedTime() < setup.maxFlightTime)
+	{
+		leSim.iterate();
+
+		if (leSim.mslWithinTgtHitRadius())
+		{
+			result.hit = true;
+			break;
+		}
+
+		if (!leSim.mslSpeedMoreThanTgtSpeed())
+			break;
+	}
+
+	result.missDistance = leSim.getMissDistance();
+	result.timeOfFlight = result.hit ? leSim.getFuzeTime() : leSim.getElapsedTime();
+	result.stepCount = leSim.getStepCount();
+
+	return result;
+}
+
+void BatchRunner::_runLockstep(std::size_t engagementCount)
+{
+	const std::size_t chunkCount = (engagementCount + LockstepBatch::chunkSize - 1) / LockstepBatch::chunkSize;
+
+	// задача пула - связка соседних прогонов; зёрна те же, что и при прогоне по одному
+	_pool.parallelFor(chunkCount, [this, engagementCount](std::size_t chunk)
+	{
+		std::size_t first = chunk * LockstepBatch::chunkSize;
+		std::size_t count = std::min(LockstepBatch::chunkSize, engagementCount - first);
+		std::vector<std::uint64_t> seeds(count);
+		LockstepBatch batch(_setup);
+
+		for (std::size_t i = 0; i < count; ++i)
+			seeds[i] = deriveSeed(_masterSeed, first + i);
+
+		batch.run(seeds.data(), _results.data() + first, count);
+	});
+}
+
+std::uint64_t BatchRunner::deriveSeed(std::uint64_t masterSeed, std::uint64_t engagementIndex)
+{
+	return CounterRng::deriveKey(masterSeed, engagementIndex);
+}
+
+DistributionSummary DistributionSummary::fromSamples(std::vector<double> samples, std::size_t binCount)
+{
+	DistributionSummary summary;
+
+	if (samples.empty())
+		return summary;
+
+	std::sort(samples.begin(), samples.end());
+
+	auto percentile = [&samples](double p) { return samples[std::min(samples.size() - 1, std::size_t(p * (samples.size() - 1) + 0.5))]; };
+	double sum = std::accumulate(samples.begin(), samples.end(), 0.);
+	double squaredDeviationSum = 0;
+
+	summary.count = samples.size();
+	summary.min = samples.front();
+	summary.max = samples.back();
+	summary.mean = sum / summary.count;
+
+	for (auto sample : samples)
+		squaredDeviationSum += pow(sample - summary.mean, 2);
+
+	summary.stdDev = sqrt(squaredDeviationSum / summary.count);
+	summary.p50 = percentile(0.5);
+	summary.p90 = percentile(0.9);
+	summary.p99 = percentile(0.99);
+
+	summary.histogram.assign(std::max<std::size_t>(binCount, 1), 0);
+	summary.histogramMin = summary.min;
+	summary.histogramBinWidth = (summary.max - summary.min) / summary.histogram.size();
+
+	for (auto sample : samples)
+	{
+		auto bin = summary.histogramBinWidth > 0 ? std::size_t((sample - summary.min) / summary.histogramBinWidth) : 0;
+		summary.histogram[std::min(bin, summary.histogram.size() - 1)]++;
+	}
+
+	return summary;
+}
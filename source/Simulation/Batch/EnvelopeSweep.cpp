@@ -0,0 +1,144 @@
+#include "Simulation/Batch/EnvelopeSweep.hpp"
+
+#include <cmath>
+#include <functional>
+
+namespace
+{
+	// ищет границу между дальностями inside (перехват удался) и outside (не удался) с заданной точностью
+	double bisect(double inside, double outside, double tolerance, const std::function<bool(double)>& isInside)
+	{
+		while (std::abs(outside - inside) > tolerance)
+		{
+			double middle = 0.5 * (inside + outside);
+			(isInside(middle) ? inside : outside) = middle;
+		}
+
+		return inside;
+	}
+}
+
+std::vector<double> EnvelopeGrid::linspace(double first, double last, std::size_t count)
+{
+	std::vector<double> values;
+
+	for (std::size_t i = 0; i < count; ++i)
+		values.push_back(count > 1 ? first + (last - first) * i / (count - 1) : first);
+
+	return values;
+}
+
+const EnvelopeCell& EnvelopeResult::at(std::size_t targetIndex, std::size_t missileIndex, std::size_t navIndex) const
+{
+	return cells[(navIndex * grid.missileSpeeds.size() + missileIndex) * grid.targetSpeeds.size() + targetIndex];
+}
+
+std::vector<double> EnvelopeResult::heatmap(Metric metric, std::size_t navIndex) const
+{
+	std::vector<double> values;
+
+	for (std::size_t missileIndex = 0; missileIndex < grid.missileSpeeds.size(); ++missileIndex)
+	{
+		for (std::size_t targetIndex = 0; targetIndex < grid.targetSpeeds.size(); ++targetIndex)
+		{
+			const auto& cell = at(targetIndex, missileIndex, navIndex);
+			values.push_back(metric == Metric::RMin ? cell.rMin : metric == Metric::RMax ? cell.rMax : cell.rNoEscape);
+		}
+	}
+
+	return values;
+}
+
+std::size_t EnvelopeResult::getTotalRunCount() const
+{
+	std::size_t runCount = 0;
+
+	for (const auto& cell : cells)
+		runCount += cell.runCount;
+
+	return runCount;
+}
+
+EnvelopeSweep::EnvelopeSweep(const EnvelopeGrid& grid, unsigned threadCount) : _grid(grid), _pool(threadCount) {}
+
+EnvelopeResult EnvelopeSweep::run()
+{
+	EnvelopeResult result;
+	const auto targetCount = _grid.targetSpeeds.size();
+	const auto missileCount = _grid.missileSpeeds.size();
+
+	result.grid = _grid;
+	result.cells.resize(targetCount * missileCount * _grid.navConstants.size());
+
+	_pool.parallelFor(result.cells.size(), [&](std::size_t i)
+	{
+		auto targetIndex = i % targetCount;
+		auto missileIndex = i / targetCount % missileCount;
+		auto navIndex = i / targetCount / missileCount;
+
+		result.cells[i] = evaluateCell(_grid, _grid.targetSpeeds[targetIndex], _grid.missileSpeeds[missileIndex], _grid.navConstants[navIndex], BatchRunner::deriveSeed(_grid.masterSeed, i));
+	});
+
+	return result;
+}
+
+EnvelopeCell EnvelopeSweep::evaluateCell(const EnvelopeGrid& grid, double targetSpeed, double missileSpeed, double navConstant, std::uint64_t cellSeed)
+{
+	EnvelopeCell cell;
+	EngagementSetup setup;
+	double insideDistance = 0;
+
+	cell.targetSpeed = setup.targetSpeed = targetSpeed;
+	cell.missileSpeed = setup.missileSpeed = missileSpeed;
+	cell.navConstant = setup.navConstant = navConstant;
+	setup.maxFlightTime = grid.maxFlightTime;
+	setup.integration = grid.integration;
+
+	// прогон останавливается, как только исход ясен - поражение цели или потеря ракетой скорости
+	auto hitsStraightTarget = [&](double distance)
+	{
+		setup.targetDistance = distance;
+		setup.evasiveTarget = false;
+		cell.runCount++;
+
+		return BatchRunner::runEngagement(setup, cellSeed).hit;
+	};
+
+	// граница неизбежного поражения - проверка дальности прекращается на первом промахе
+	auto hitsEvasiveTarget = [&](double distance)
+	{
+		setup.targetDistance = distance;
+		setup.evasiveTarget = true;
+
+		for (std::size_t sample = 0; sample < grid.evasiveSamples; ++sample)
+		{
+			cell.runCount++;
+
+			if (!BatchRunner::runEngagement(setup, BatchRunner::deriveSeed(cellSeed, sample)).hit)
+				return false;
+		}
+
+		return true;
+	};
+
+	// ищем хотя бы одну дальность внутри зоны, перебирая пробные дальности в геометрической прогрессии от большей к меньшей
+	for (std::size_t probe = 0; probe < grid.probeCount && !insideDistance; ++probe)
+	{
+		double ratio = grid.probeCount > 1 ? double(probe) / (grid.probeCount - 1) : 0;
+		double distance = grid.maxDistance * pow(grid.minDistance / grid.maxDistance, ratio);
+
+		if (hitsStraightTarget(distance))
+			insideDistance = distance;
+	}
+
+	if (!insideDistance)
+		return cell;
+
+	cell.rMax = insideDistance >= grid.maxDistance ? grid.maxDistance : bisect(insideDistance, grid.maxDistance, grid.distanceTolerance, hitsStraightTarget);
+	cell.rMin = insideDistance <= grid.minDistance || hitsStraightTarget(grid.minDistance) ? grid.minDistance : bisect(insideDistance, grid.minDistance, grid.distanceTolerance, hitsStraightTarget);
+
+	if (hitsEvasiveTarget(cell.rMin))
+		cell.rNoEscape = hitsEvasiveTarget(cell.rMax) ? cell.rMax : bisect(cell.rMin, cell.rMax, grid.distanceTolerance, hitsEvasiveTarget);
+
+	return cell;
+}
@@ -0,0 +1,290 @@
+#include "Simulation/Batch/LockstepBatch.hpp"
+#include "Simulation/CommonSimParams.hpp"
+#include "Simulation/Auxilary/SimdMath.hpp"
+#include "Simulation/Auxilary/utils.hpp"
+#include "Simulation/SimObjects/DescriptorCatalog.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+using SimdMath::SimdLanes;
+
+LockstepBatch::LockstepBatch(const EngagementSetup& setup, std::shared_ptr<const Missile::MissileDesc> missileDesc, std::shared_ptr<const Target::TargetDesc> targetDesc) :
+_setup(setup),
+_missileDesc(missileDesc ? std::move(missileDesc) : DescriptorCatalog::instance().getMissileDesc()),
+_targetDesc(targetDesc ? std::move(targetDesc) : DescriptorCatalog::instance().getTargetDesc())
+{
+}
+
+void LockstepBatch::run(const std::uint64_t* seeds, EngagementResult* results, std::size_t count)
+{
+	// хвост до целого пакета заполняется закончившимися полосами - пакеты всегда читаются целиком
+	const std::size_t laneCount = (count + SimdLanes::width - 1) / SimdLanes::width * SimdLanes::width;
+
+	for (auto& field : _fields)
+		field.assign(laneCount, 0);
+
+	_rngs.assign(laneCount, CounterRng());
+	_resultIndices.resize(laneCount);
+
+	for (std::size_t lane = 0; lane < laneCount; ++lane)
+	{
+		_initLane(lane, lane < count ? seeds[lane] : 0);
+		_resultIndices[lane] = lane;
+
+		if (lane < count)
+			results[lane] = EngagementResult{ seeds[lane] };
+		else
+			_field(IsActive)[lane] = 0;
+	}
+
+	_activeCount = count;
+
+	double elapsedTime = 0;
+	std::uint64_t stepCount = 0;
+
+	// время ракеты совпадает со временем перехвата, поэтому включение автопилота - общее для всех полос
+	while (_activeCount && elapsedTime < _setup.maxFlightTime)
+	{
+		double endTime = elapsedTime + SIM_RESOLUTION;
+
+		_step<SimdLanes>(elapsedTime, endTime, elapsedTime >= _missileDesc->apDelay);
+		elapsedTime = endTime;
+		stepCount++;
+		_retireFinished(elapsedTime, stepCount, results);
+	}
+
+	// оставшиеся перехваты прерваны по времени
+	for (std::size_t lane = 0; lane < _activeCount; ++lane)
+	{
+		auto& result = results[_resultIndices[lane]];
+
+		result.missDistance = std::sqrt(_field(MissDistanceSq)[lane]);
+		result.timeOfFlight = elapsedTime;
+		result.stepCount = stepCount;
+	}
+}
+
+void LockstepBatch::_initLane(std::size_t lane, std::uint64_t seed)
+{
+	// то же начальное состояние, что у BatchRunner::runEngagement
+	_field(MissileVelY)[lane] = _setup.missileSpeed;
+	_field(FuelMass)[lane] = _missileDesc->motorFuelMass;
+	_field(IsLocked)[lane] = 1;
+	_field(TargetY)[lane] = _setup.targetDistance;
+	_field(TargetVelY)[lane] = -_setup.targetSpeed;
+	_field(ManeuverDuration)[lane] = std::numeric_limits<double>::infinity();
+	_field(MissDistanceSq)[lane] = Vec2d(0, _setup.targetDistance).lengthSquared();
+	_field(IsActive)[lane] = 1;
+
+	_rngs[lane].seed(CounterRng::deriveKey(seed, 0)); // поток цели, как в Simulation::seed
+
+	if (_setup.evasiveTarget)
+		_drawManeuver(lane);
+}
+
+void LockstepBatch::_drawManeuver(std::size_t lane)
+{
+	const auto& [minTime, maxTime] = _targetDesc->evManeuverTimeConstraints;
+	const auto& [minAccel, maxAccel] = _targetDesc->evManeuverAccelConstraints;
+
+	// порядок розыгрыша как в Target::_setUpAccelerationParameters - меняется только продольная составляющая ускорения
+	_field(ManeuverTime)[lane] = 0;
+	_field(ManeuverDuration)[lane] = _rngs[lane].nextInRange(minTime, maxTime);
+	_field(TargetAccX)[lane] = _rngs[lane].nextInRange(minAccel, maxAccel);
+}
+
+template <typename Lanes> void LockstepBatch::_step(double startTime, double endTime, bool isGuidanceEnabled)
+{
+	using L = Lanes;
+	const auto& desc = *_missileDesc;
+	const double fuelConsumptionRate = desc.motorFuelMass / desc.motorBurnTime;
+
+	const auto zero = L::set(0), one = L::set(1);
+	const auto timeStep = L::set(SIM_RESOLUTION), stepLength = L::set(endTime - startTime), stepStart = L::set(startTime);
+	const auto accelerationStep = L::set(std::pow(SIM_RESOLUTION, 2) * FREEFALL_ACC * 0.5);
+	const auto guidanceMask = L::equal(L::set(isGuidanceEnabled), one);
+	const auto maxOffBoresight = L::set(degToRad(desc.seekerMaxOBA));
+	const auto steeringGain = L::set(degToRad(_setup.navConstant)); // как в Missile::_calculateSteeringAngle, угол умножается на degToRad
+	const auto emptyMass = L::set(desc.emptyMass);
+	const auto engineThrust = L::set(desc.motorSpecImpulse * fuelConsumptionRate * FREEFALL_ACC);
+	const auto fuelPerStep = L::set(fuelConsumptionRate * SIM_RESOLUTION);
+	const auto dynPressureFactor = L::set(AIR_DENSITY * desc.planformArea / 2);
+	const auto inducedDragFactor = L::set(radToDeg(1) * desc.DyPerDa); // угол атаки в градусах
+	const auto proxyRadiusSq = L::set(desc.proxyFuzeRadius * desc.proxyFuzeRadius);
+	const bool isSteeringInOctant = desc.seekerMaxOBA <= 45; // доворот не больше ширины ПЗ - без приведения аргумента sin/cos
+	const auto inverseSpeedOfSound = L::set(1. / SPEED_OF_SOUND);
+	const double* tableValues = desc.cXTable.getValues().data();
+	const auto tableMinArg = L::set(desc.cXTable.getMinArg()), tableInvStep = L::set(desc.cXTable.getInvStep());
+	const auto tableLastPosition = L::set(desc.cXTable.getLastPosition()), tableMaxIndex = L::set(double(desc.cXTable.getValues().size() - 2));
+
+	for (std::size_t lane = 0; lane < _activeCount; lane += L::width)
+	{
+		auto isActive = L::equal(L::load(_field(IsActive) + lane), one);
+		auto isLocked = L::equal(L::load(_field(IsLocked) + lane), one);
+		auto missileX = L::load(_field(MissileX) + lane), missileY = L::load(_field(MissileY) + lane);
+		auto missileVelX = L::load(_field(MissileVelX) + lane), missileVelY = L::load(_field(MissileVelY) + lane);
+		auto fuelMass = L::load(_field(FuelMass) + lane);
+		auto targetX = L::load(_field(TargetX) + lane), targetY = L::load(_field(TargetY) + lane);
+		auto targetVelX = L::load(_field(TargetVelX) + lane), targetVelY = L::load(_field(TargetVelY) + lane);
+		auto targetAccX = L::load(_field(TargetAccX) + lane), targetAccY = L::load(_field(TargetAccY) + lane);
+		auto startRelX = L::sub(targetX, missileX), startRelY = L::sub(targetY, missileY);
+		typename L::Pack sine, cosine;
+
+		// цель: хорда дуги отклонена от скорости на половину угла поворота за шаг (Target::basicMove)
+		auto deltaX = L::add(L::mul(targetVelX, timeStep), L::mul(targetAccX, accelerationStep));
+		auto deltaY = L::add(L::mul(targetVelY, timeStep), L::mul(targetAccY, accelerationStep));
+		auto chordCross = L::sub(L::mul(targetVelX, deltaY), L::mul(targetVelY, deltaX));
+		auto chordDot = L::add(L::mul(targetVelX, deltaX), L::mul(targetVelY, deltaY));
+
+		// синус и косинус удвоенного угла между скоростью и хордой - прямо из скалярного и векторного произведений, без atan2 и sin/cos
+		auto chordNormSq = L::add(L::mul(chordDot, chordDot), L::mul(chordCross, chordCross));
+		auto isChordValid = L::less(zero, chordNormSq);
+		auto inverseChordNormSq = L::div(one, L::select(isChordValid, chordNormSq, one));
+		sine = L::mul(L::mul(L::set(2), L::mul(chordDot, chordCross)), inverseChordNormSq);
+		cosine = L::select(isChordValid, L::mul(L::sub(L::mul(chordDot, chordDot), L::mul(chordCross, chordCross)), inverseChordNormSq), one);
+
+		auto newTargetVelX = L::sub(L::mul(targetVelX, cosine), L::mul(targetVelY, sine));
+		auto newTargetVelY = L::add(L::mul(targetVelX, sine), L::mul(targetVelY, cosine));
+		auto newTargetAccX = L::sub(L::mul(targetAccX, cosine), L::mul(targetAccY, sine));
+		auto newTargetAccY = L::add(L::mul(targetAccX, sine), L::mul(targetAccY, cosine));
+		targetX = L::select(isActive, L::add(targetX, deltaX), targetX);
+		targetY = L::select(isActive, L::add(targetY, deltaY), targetY);
+		targetVelX = L::select(isActive, newTargetVelX, targetVelX);
+		targetVelY = L::select(isActive, newTargetVelY, targetVelY);
+
+		L::store(_field(TargetX) + lane, targetX);
+		L::store(_field(TargetY) + lane, targetY);
+		L::store(_field(TargetVelX) + lane, targetVelX);
+		L::store(_field(TargetVelY) + lane, targetVelY);
+		L::store(_field(TargetAccX) + lane, L::select(isActive, newTargetAccX, targetAccX));
+		L::store(_field(TargetAccY) + lane, L::select(isActive, newTargetAccY, targetAccY));
+		L::store(_field(ManeuverTime) + lane, L::add(L::load(_field(ManeuverTime) + lane), L::select(isActive, timeStep, zero)));
+
+		// ракета наводится на новое положение цели; при выходе цели из ПЗ захват срывается, и на этом шаге ракета не движется (Missile::advancedMove)
+		auto isGuided = L::both(L::both(isActive, isLocked), guidanceMask);
+		auto losX = L::sub(targetX, missileX), losY = L::sub(targetY, missileY);
+		// у неподвижной ракеты угол отсчитывается от оси X, как atan2(0, 0) = 0 в getAngleBetweenVectorsRad
+		auto isStationary = L::both(L::equal(missileVelX, zero), L::equal(missileVelY, zero));
+		auto headingX = L::select(isStationary, one, missileVelX), headingY = L::select(isStationary, zero, missileVelY);
+		auto losAngle = SimdMath::computeAtan2<L>(L::sub(L::mul(headingX, losY), L::mul(headingY, losX)), L::add(L::mul(headingX, losX), L::mul(headingY, losY)));
+		auto isLost = L::both(isGuided, L::less(maxOffBoresight, L::abs(losAngle)));
+		auto steeringAngle = L::max(L::sub(zero, maxOffBoresight), L::min(L::mul(steeringGain, losAngle), maxOffBoresight));
+		steeringAngle = L::select(L::andNot(isGuided, isLost), steeringAngle, zero);
+
+		if (isSteeringInOctant)
+			SimdMath::computeSinCosInOctant<L>(steeringAngle, sine, cosine);
+		else
+			SimdMath::computeSinCos<L>(steeringAngle, sine, cosine);
+
+		auto velX = L::sub(L::mul(missileVelX, cosine), L::mul(missileVelY, sine));
+		auto velY = L::add(L::mul(missileVelX, sine), L::mul(missileVelY, cosine));
+		auto speed = L::sqrt(L::add(L::mul(velX, velX), L::mul(velY, velY)));
+		auto inverseMass = L::div(one, L::add(fuelMass, emptyMass));
+		auto thrustAcceleration = L::select(L::less(zero, fuelMass), L::mul(engineThrust, inverseMass), zero);
+
+		// Cx0(M) - та же линейная интерполяция по равномерной сетке, что и в UniformLookupTable::operator()
+		auto tablePosition = L::max(zero, L::min(L::mul(L::sub(L::mul(speed, inverseSpeedOfSound), tableMinArg), tableInvStep), tableLastPosition));
+		auto tableIndex = L::min(L::floor(tablePosition), tableMaxIndex);
+		auto lowerValue = L::gather(tableValues, tableIndex);
+		auto zeroLiftDrag = L::add(lowerValue, L::mul(L::sub(L::gather(tableValues + 1, tableIndex), lowerValue), L::sub(tablePosition, tableIndex)));
+
+		auto dragCoefficient = L::add(zeroLiftDrag, L::mul(steeringAngle, inducedDragFactor));
+		auto dragDeceleration = L::mul(L::mul(L::mul(dynPressureFactor, L::mul(speed, speed)), dragCoefficient), inverseMass);
+		// приращение скорости вдоль её направления, отнесённое к скорости; неподвижная ракета, как Vec2d::normalized в Missile::basicMove, не ускоряется
+		auto isSpeedPositive = L::less(zero, speed);
+		auto speedRatio = L::select(isSpeedPositive, L::div(L::mul(timeStep, L::sub(thrustAcceleration, dragDeceleration)), L::select(isSpeedPositive, speed, one)), zero);
+		velX = L::add(velX, L::mul(velX, speedRatio));
+		velY = L::add(velY, L::mul(velY, speedRatio));
+
+		auto isMoving = L::andNot(isActive, isLost);
+		missileX = L::select(isMoving, L::add(missileX, L::mul(velX, timeStep)), missileX);
+		missileY = L::select(isMoving, L::add(missileY, L::mul(velY, timeStep)), missileY);
+		missileVelX = L::select(isMoving, velX, missileVelX);
+		missileVelY = L::select(isMoving, velY, missileVelY);
+		fuelMass = L::select(isMoving, L::sub(fuelMass, L::min(fuelPerStep, fuelMass)), fuelMass);
+		isLocked = L::andNot(isLocked, isLost);
+
+		L::store(_field(MissileX) + lane, missileX);
+		L::store(_field(MissileY) + lane, missileY);
+		L::store(_field(MissileVelX) + lane, missileVelX);
+		L::store(_field(MissileVelY) + lane, missileVelY);
+		L::store(_field(FuelMass) + lane, fuelMass);
+		L::store(_field(IsLocked) + lane, L::select(isLocked, one, zero));
+
+		// наибольшее сближение на шаге и вход в зону поражения - как в Simulation::_checkEndgame
+		auto endRelX = L::sub(targetX, missileX), endRelY = L::sub(targetY, missileY);
+		auto relDeltaX = L::sub(endRelX, startRelX), relDeltaY = L::sub(endRelY, startRelY);
+		auto deltaSquared = L::add(L::mul(relDeltaX, relDeltaX), L::mul(relDeltaY, relDeltaY));
+		auto projection = L::add(L::mul(startRelX, relDeltaX), L::mul(startRelY, relDeltaY));
+		auto isMovingRelatively = L::less(zero, deltaSquared);
+		auto fraction = L::select(isMovingRelatively, L::max(zero, L::min(L::div(L::sub(zero, projection), deltaSquared), one)), zero);
+		auto closestX = L::add(startRelX, L::mul(fraction, relDeltaX)), closestY = L::add(startRelY, L::mul(fraction, relDeltaY));
+		auto distanceSq = L::add(L::mul(closestX, closestX), L::mul(closestY, closestY));
+
+		auto missDistanceSq = L::load(_field(MissDistanceSq) + lane);
+		auto isCloser = L::both(isActive, L::less(distanceSq, missDistanceSq));
+
+		L::store(_field(MissDistanceSq) + lane, L::select(isCloser, distanceSq, missDistanceSq));
+
+		auto isFuzed = L::both(isActive, L::lessEqual(distanceSq, proxyRadiusSq));
+
+		// момент входа в зону поражения нужен только на шаге срабатывания НВ
+		if (L::bits(isFuzed))
+		{
+			auto startDistanceExcess = L::sub(L::add(L::mul(startRelX, startRelX), L::mul(startRelY, startRelY)), proxyRadiusSq);
+			auto discriminant = L::sub(L::mul(projection, projection), L::mul(deltaSquared, startDistanceExcess));
+			auto entryRoot = L::div(L::sub(L::sub(zero, projection), L::sqrt(L::max(discriminant, zero))), L::select(isMovingRelatively, deltaSquared, one));
+			auto isEntryValid = L::both(L::both(isMovingRelatively, L::lessEqual(zero, discriminant)), L::lessEqual(entryRoot, one));
+			auto entryFraction = L::select(L::andNot(isEntryValid, L::lessEqual(startDistanceExcess, zero)), L::max(entryRoot, zero), zero);
+
+			L::store(_field(FuzeTime) + lane, L::select(isFuzed, L::add(stepStart, L::mul(entryFraction, stepLength)), L::load(_field(FuzeTime) + lane)));
+			L::store(_field(IsHit) + lane, L::select(isFuzed, one, L::load(_field(IsHit) + lane)));
+		}
+
+		// после выгорания топлива перехват продолжается, пока ракета с захватом быстрее цели (Simulation::mslSpeedMoreThanTgtSpeed)
+		auto missileSpeedSq = L::add(L::mul(missileVelX, missileVelX), L::mul(missileVelY, missileVelY));
+		auto targetSpeedSq = L::add(L::mul(targetVelX, targetVelX), L::mul(targetVelY, targetVelY));
+		auto isUseful = L::either(L::less(zero, fuelMass), L::both(isLocked, L::less(targetSpeedSq, missileSpeedSq)));
+
+		L::store(_field(IsActive) + lane, L::select(L::andNot(L::both(isActive, isUseful), isFuzed), one, zero));
+	}
+}
+
+void LockstepBatch::_retireFinished(double elapsedTime, std::uint64_t stepCount, EngagementResult* results)
+{
+	for (std::size_t lane = 0; lane < _activeCount;)
+	{
+		if (!_field(IsActive)[lane])
+		{
+			auto& result = results[_resultIndices[lane]];
+
+			result.hit = _field(IsHit)[lane] != 0;
+			result.missDistance = std::sqrt(_field(MissDistanceSq)[lane]);
+			result.timeOfFlight = result.hit ? _field(FuzeTime)[lane] : elapsedTime;
+			result.stepCount = stepCount;
+
+			// на место закончившегося - последний незакончившийся, чтобы пакеты оставались заполненными
+			_swapLanes(lane, --_activeCount);
+			continue;
+		}
+
+		if (_setup.evasiveTarget && _field(ManeuverTime)[lane] >= _field(ManeuverDuration)[lane])
+			_drawManeuver(lane);
+
+		++lane;
+	}
+}
+
+void LockstepBatch::_swapLanes(std::size_t first, std::size_t second)
+{
+	if (first == second)
+		return;
+
+	for (auto& field : _fields)
+		std::swap(field[first], field[second]);
+
+	std::swap(_rngs[first], _rngs[second]);
+	std::swap(_resultIndices[first], _resultIndices[second]);
+}
@@ -0,0 +1,193 @@
+#include "Simulation/Recording/BlockCodec.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+	constexpr std::size_t minMatch = 4;			// кратчайшее кодируемое совпадение
+	constexpr std::size_t matchSearchLimit = 12;	// совпадения не начинаются ближе к концу блока (как в LZ4)
+	constexpr std::size_t lastLiterals = 5;		// последние байты блока всегда передаются литералами
+	constexpr std::size_t maxOffset = 65535;
+	constexpr unsigned hashBits = 12;
+
+	std::uint32_t read32(const std::uint8_t* p)
+	{
+		std::uint32_t value;
+		std::memcpy(&value, p, sizeof(value));
+
+		return value;
+	}
+
+	std::uint32_t hash32(std::uint32_t sequence)
+	{
+		return (sequence * 2654435761u) >> (32 - hashBits);
+	}
+
+	void writeLength(std::vector<std::uint8_t>& destination, std::size_t length) // продолжение длины байтами по 255
+	{
+		for (; length >= 255; length -= 255)
+			destination.push_back(255);
+
+		destination.push_back(static_cast<std::uint8_t>(length));
+	}
+
+	void writeSequence(std::vector<std::uint8_t>& destination, const std::uint8_t* literals, std::size_t literalCount, std::size_t offset, std::size_t matchLength)
+	{
+		std::size_t matchCode = matchLength ? matchLength - minMatch : 0;
+		auto token = static_cast<std::uint8_t>((std::min<std::size_t>(literalCount, 15) << 4) | std::min<std::size_t>(matchCode, 15));
+
+		destination.push_back(token);
+
+		if (literalCount >= 15)
+			writeLength(destination, literalCount - 15);
+
+		destination.insert(destination.end(), literals, literals + literalCount);
+
+		if (!matchLength)
+			return;
+
+		destination.push_back(static_cast<std::uint8_t>(offset & 0xFF));
+		destination.push_back(static_cast<std::uint8_t>(offset >> 8));
+
+		if (matchCode >= 15)
+			writeLength(destination, matchCode - 15);
+	}
+
+	std::size_t readLength(const std::uint8_t*& p, const std::uint8_t* end)
+	{
+		std::size_t length = 0;
+		std::uint8_t byte;
+
+		do
+		{
+			if (p >= end)
+				throw BlockCodec::CorruptDataError("truncated length");
+
+			byte = *p++;
+			length += byte;
+		} while (byte == 255);
+
+		return length;
+	}
+}
+
+void BlockCodec::shuffle(const std::uint8_t* source, std::uint8_t* destination, std::size_t size, std::size_t elementSize)
+{
+	const std::size_t count = size / elementSize;
+
+	for (std::size_t byte = 0; byte < elementSize; ++byte)
+		for (std::size_t i = 0; i < count; ++i)
+			destination[byte * count + i] = source[i * elementSize + byte];
+
+	std::memcpy(destination + count * elementSize, source + count * elementSize, size - count * elementSize); // неполный хвост - как есть
+}
+
+void BlockCodec::unshuffle(const std::uint8_t* source, std::uint8_t* destination, std::size_t size, std::size_t elementSize)
+{
+	const std::size_t count = size / elementSize;
+
+	for (std::size_t byte = 0; byte < elementSize; ++byte)
+		for (std::size_t i = 0; i < count; ++i)
+			destination[i * elementSize + byte] = source[byte * count + i];
+
+	std::memcpy(destination + count * elementSize, source + count * elementSize, size - count * elementSize);
+}
+
+void BlockCodec::lzCompress(const std::uint8_t* source, std::size_t size, std::vector<std::uint8_t>& destination)
+{
+	constexpr std::uint32_t emptySlot = 0xFFFFFFFFu;
+	std::vector<std::uint32_t> table(std::size_t(1) << hashBits, emptySlot);
+	std::size_t anchor = 0;
+	std::size_t pos = 0;
+
+	while (size > matchSearchLimit && pos + matchSearchLimit < size)
+	{
+		auto sequence = read32(source + pos);
+		auto& slot = table[hash32(sequence)];
+		std::size_t candidate = slot;
+
+		slot = static_cast<std::uint32_t>(pos);
+
+		if (candidate == emptySlot || pos - candidate > maxOffset || read32(source + candidate) != sequence)
+		{
+			pos++;
+			continue;
+		}
+
+		std::size_t matchLength = minMatch;
+
+		while (pos + matchLength < size - lastLiterals && source[candidate + matchLength] == source[pos + matchLength])
+			matchLength++;
+
+		writeSequence(destination, source + anchor, pos - anchor, pos - candidate, matchLength);
+		pos += matchLength;
+		anchor = pos;
+	}
+
+	writeSequence(destination, source + anchor, size - anchor, 0, 0);
+}
+
+void BlockCodec::lzDecompress(const std::uint8_t* source, std::size_t size, std::uint8_t* destination, std::size_t rawSize)
+{
+	const std::uint8_t* p = source;
+	const std::uint8_t* end = source + size;
+	std::size_t out = 0;
+
+	while (p < end)
+	{
+		std::uint8_t token = *p++;
+		std::size_t literalCount = token >> 4;
+
+		if (literalCount == 15)
+			literalCount += readLength(p, end);
+
+		if (literalCount > std::size_t(end - p) || literalCount > rawSize - out)
+			throw CorruptDataError("literal run out of bounds");
+
+		std::memcpy(destination + out, p, literalCount);
+		p += literalCount;
+		out += literalCount;
+
+		if (p == end)
+			break; // последняя последовательность состоит только из литералов
+
+		if (end - p < 2)
+			throw CorruptDataError("truncated match offset");
+
+		std::size_t offset = p[0] | (std::size_t(p[1]) << 8);
+		std::size_t matchLength = (token & 0x0F);
+		p += 2;
+
+		if (matchLength == 15)
+			matchLength += readLength(p, end);
+
+		matchLength += minMatch;
+
+		if (!offset || offset > out || matchLength > rawSize - out)
+			throw CorruptDataError("match out of bounds");
+
+		// побайтное копирование - источник и приёмник могут перекрываться
+		for (std::size_t i = 0; i < matchLength; ++i, ++out)
+			destination[out] = destination[out - offset];
+	}
+
+	if (out != rawSize)
+		throw CorruptDataError("decompressed size mismatch");
+}
+
+void BlockCodec::compress(const std::uint8_t* source, std::size_t size, std::size_t elementSize, std::vector<std::uint8_t>& destination)
+{
+	std::vector<std::uint8_t> shuffled(size);
+
+	shuffle(source, shuffled.data(), size, elementSize);
+	lzCompress(shuffled.data(), size, destination);
+}
+
+void BlockCodec::decompress(const std::uint8_t* source, std::size_t size, std::size_t elementSize, std::uint8_t* destination, std::size_t rawSize)
+{
+	std::vector<std::uint8_t> shuffled(rawSize);
+
+	lzDecompress(source, size, shuffled.data(), rawSize);
+	unshuffle(shuffled.data(), destination, rawSize, elementSize);
+}
@@ -0,0 +1,210 @@
+#include "Simulation/Recording/TrajectoryArchive.hpp"
+#include "Simulation/Recording/TrajectoryReader.hpp"
+#include "Simulation/Auxilary/TraceRecorder.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace
+{
+	std::uint64_t alignTo8(std::uint64_t value) { return (value + 7) & ~std::uint64_t(7); }
+}
+
+TrajectoryArchive::TrajectoryArchive(const std::string& filePath) : _file(filePath)
+{
+	using namespace TrajectoryArchiveFormat;
+
+	const auto* data = _file.getData();
+	const auto size = _file.getSize();
+
+	if (size < headerSize)
+		throw std::runtime_error(filePath + " is not a trajectory archive");
+
+	std::memcpy(&_header, data, sizeof(_header));
+
+	if (std::memcmp(_header.magic, magic, sizeof(magic)))
+		throw std::runtime_error(filePath + " is not a trajectory archive");
+
+	if (_header.version > version)
+		throw std::runtime_error(filePath + " was written by a newer version");
+
+	// имена столбцов
+	std::size_t offset = headerSize;
+
+	_columnNames.resize(_header.columnCount);
+
+	for (auto& name : _columnNames)
+	{
+		std::uint16_t length;
+
+		if (offset + sizeof(length) > size)
+			throw std::runtime_error(filePath + " has a truncated header");
+
+		std::memcpy(&length, data + offset, sizeof(length));
+		offset += sizeof(length);
+
+		if (offset + length > size)
+			throw std::runtime_error(filePath + " has a truncated header");
+
+		name.assign(reinterpret_cast<const char*>(data + offset), length);
+		offset += length;
+	}
+
+	if (_columnNames.size() != TrajectoryFormat::ColumnCount || _columnNames[TrajectoryFormat::Time] != TrajectoryFormat::columnNames()[TrajectoryFormat::Time])
+		throw std::runtime_error(filePath + " has an unexpected column layout");
+
+	_indexSize = _header.indexStride ? std::size_t((_header.recordCount + _header.indexStride - 1) / _header.indexStride) : 0;
+
+	const auto columnsSize = std::uint64_t(_header.columnCount) * _header.recordCount * sizeof(double);
+
+	if (!_header.indexStride || _header.columnsOffset % 8 || _header.indexOffset % 8 || _header.columnsOffset < offset
+		|| _header.columnsOffset + columnsSize > _header.indexOffset || _header.indexOffset + _indexSize * sizeof(double) > size)
+		throw std::runtime_error(filePath + " is truncated or corrupt");
+
+	// отображение выровнено по странице, смещения - по 8, так что столбцы можно читать как массивы double
+	_columns = reinterpret_cast<const double*>(data + _header.columnsOffset);
+	_index = reinterpret_cast<const double*>(data + _header.indexOffset);
+}
+
+std::size_t TrajectoryArchive::findRecord(double time) const
+{
+	const auto recordCount = getRecordCount();
+	const auto stride = std::size_t(_header.indexStride);
+
+	// индекс указывает на отрезок из stride записей, внутри которого остаётся бинарный поиск по столбцу времени
+	auto indexPosition = std::size_t(std::lower_bound(_index, _index + _indexSize, time) - _index);
+	auto first = indexPosition ? (indexPosition - 1) * stride : 0;
+	auto last = indexPosition < _indexSize ? indexPosition * stride : recordCount;
+	const auto* timeColumn = getColumn(TrajectoryFormat::Time);
+
+	return std::size_t(std::lower_bound(timeColumn + first, timeColumn + last, time) - timeColumn);
+}
+
+TrajectoryArchive::RecordRange TrajectoryArchive::findWindow(double startTime, double endTime) const
+{
+	RecordRange range;
+
+	range.first = findRecord(startTime);
+	range.last = std::max(range.first, findRecord(std::nextafter(endTime, HUGE_VAL)));
+
+	return range;
+}
+
+void TrajectoryArchive::prefetch(const RecordRange& range) const
+{
+	const auto columnsBase = std::size_t(_header.columnsOffset);
+
+	for (std::size_t column = 0; column < getColumnCount(); ++column)
+		_file.prefetch(columnsBase + (column * getRecordCount() + range.first) * sizeof(double), range.getSize() * sizeof(double));
+}
+
+void convertTrajectoryToArchive(const std::string& trajectoryPath, const std::string& archivePath, std::size_t indexStride)
+{
+	MGE_TRACE_SCOPE("convertTrajectoryToArchive");
+	using namespace TrajectoryArchiveFormat;
+
+	ArchiveHeader header{};
+	std::uint64_t recordCount = 0;
+
+	// первый проход: только заголовки блоков - размер столбцов нужен до раскладки
+	{
+		TrajectoryReader counter(trajectoryPath);
+
+		while (auto blockRecords = counter.skipBlock())
+			recordCount += blockRecords;
+	}
+
+	TrajectoryReader reader(trajectoryPath);
+	const auto& columns = reader.getHeader().columns;
+
+	if (columns.size() != TrajectoryFormat::ColumnCount || columns[TrajectoryFormat::Time] != TrajectoryFormat::columnNames()[TrajectoryFormat::Time])
+		throw std::runtime_error(trajectoryPath + " has an unexpected column layout");
+
+	std::vector<char> names;
+
+	for (const auto& name : columns)
+	{
+		auto length = static_cast<std::uint16_t>(name.size());
+
+		names.insert(names.end(), reinterpret_cast<const char*>(&length), reinterpret_cast<const char*>(&length) + sizeof(length));
+		names.insert(names.end(), name.begin(), name.end());
+	}
+
+	names.resize(std::size_t(alignTo8(names.size())), 0);
+
+	std::memcpy(header.magic, magic, sizeof(magic));
+	header.version = version;
+	header.columnCount = static_cast<std::uint16_t>(columns.size());
+	header.simResolution = reader.getHeader().simResolution;
+	header.recordCount = recordCount;
+	header.indexStride = std::max<std::size_t>(indexStride, 1);
+	header.columnsOffset = headerSize + names.size();
+	header.indexOffset = header.columnsOffset + columns.size() * recordCount * sizeof(double);
+
+	std::ofstream archive(archivePath, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+	char headerBytes[headerSize]{};
+
+	if (!archive.is_open())
+		throw std::runtime_error("cannot open " + archivePath);
+
+	archive.write(headerBytes, sizeof(headerBytes)); // заголовок дописывается в конце, когда известно состояние закрытия
+	archive.write(names.data(), names.size());
+
+	// второй проход: каждый блок раскладывается по столбцам и пишется в них своими кусками
+	std::vector<double> values, columnSlice, index;
+	std::uint64_t recordIndex = 0;
+	double lastTime = -HUGE_VAL;
+
+	while (reader.readBlock(values))
+	{
+		const auto blockRecords = values.size() / columns.size();
+
+		// файл мог измениться между проходами
+		if (recordIndex + blockRecords > recordCount)
+			throw std::runtime_error(trajectoryPath + " changed during conversion");
+
+		columnSlice.resize(blockRecords);
+
+		for (std::size_t column = 0; column < columns.size(); ++column)
+		{
+			for (std::size_t record = 0; record < blockRecords; ++record)
+				columnSlice[record] = values[record * columns.size() + column];
+
+			if (column == TrajectoryFormat::Time)
+			{
+				for (std::size_t record = 0; record < blockRecords; ++record)
+				{
+					if (columnSlice[record] < lastTime)
+						throw std::runtime_error(trajectoryPath + " has decreasing time");
+
+					lastTime = columnSlice[record];
+
+					if ((recordIndex + record) % header.indexStride == 0)
+						index.push_back(lastTime);
+				}
+			}
+
+			archive.seekp(std::streamoff(header.columnsOffset + (column * recordCount + recordIndex) * sizeof(double)));
+			archive.write(reinterpret_cast<const char*>(columnSlice.data()), blockRecords * sizeof(double));
+		}
+
+		recordIndex += blockRecords;
+	}
+
+	if (recordIndex != recordCount)
+		throw std::runtime_error(trajectoryPath + " changed during conversion");
+
+	header.closeState = static_cast<std::uint32_t>(reader.getCloseState());
+	std::memcpy(headerBytes, &header, sizeof(header));
+
+	archive.seekp(std::streamoff(header.indexOffset));
+	archive.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(double));
+	archive.seekp(0);
+	archive.write(headerBytes, sizeof(headerBytes));
+
+	if (!archive)
+		throw std::runtime_error("cannot write " + archivePath);
+}
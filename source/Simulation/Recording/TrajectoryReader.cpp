@@ -0,0 +1,154 @@
+#include "Simulation/Recording/TrajectoryReader.hpp"
+#include "Simulation/Recording/BlockCodec.hpp"
+#include "Simulation/Auxilary/PhaseProfiler.hpp"
+#include "Simulation/Auxilary/TraceRecorder.hpp"
+#include "Simulation/Auxilary/utils.hpp"
+#include "Simulation/Auxilary/CsvWriter.hpp"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+	template <typename T> T readValue(std::ifstream& file)
+	{
+		T value{};
+
+		if (!file.read(reinterpret_cast<char*>(&value), sizeof(value)))
+			throw std::runtime_error("unexpected end of trajectory file");
+
+		return value;
+	}
+}
+
+TrajectoryReader::TrajectoryReader(const std::string& filePath) : _file(filePath, std::ios_base::in | std::ios_base::binary)
+{
+	char magic[sizeof(TrajectoryFormat::magic)];
+
+	if (!_file.is_open())
+		throw std::runtime_error("cannot open " + filePath);
+
+	if (!_file.read(magic, sizeof(magic)) || std::memcmp(magic, TrajectoryFormat::magic, sizeof(magic)))
+		throw std::runtime_error(filePath + " is not a trajectory file");
+
+	if (readValue<std::uint16_t>(_file) > TrajectoryFormat::version)
+		throw std::runtime_error(filePath + " was written by a newer version");
+
+	_header.flags = readValue<std::uint16_t>(_file);
+	_header.simResolution = readValue<double>(_file);
+	_header.columns.resize(readValue<std::uint16_t>(_file));
+
+	for (auto& column : _header.columns)
+	{
+		column.resize(readValue<std::uint16_t>(_file));
+		_file.read(column.data(), column.size());
+	}
+
+	if (_header.columns.empty())
+		throw std::runtime_error(filePath + " has no columns");
+}
+
+bool TrajectoryReader::readBlock(std::vector<double>& values)
+{
+	std::uint32_t recordCount, payloadSize, rawSize;
+
+	if (!_readBlockHeader(recordCount, payloadSize, rawSize))
+		return false;
+
+	if (rawSize != std::size_t(recordCount) * getColumnCount() * sizeof(double))
+		throw std::runtime_error("trajectory block size mismatch");
+
+	values.resize(std::size_t(recordCount) * getColumnCount());
+
+	if (_header.flags & TrajectoryFormat::compressedFlag)
+	{
+		_payload.resize(payloadSize);
+
+		if (!_file.read(reinterpret_cast<char*>(_payload.data()), payloadSize))
+			throw std::runtime_error("truncated trajectory block");
+
+		BlockCodec::decompress(_payload.data(), payloadSize, sizeof(double), reinterpret_cast<std::uint8_t*>(values.data()), rawSize);
+	}
+	else if (!_file.read(reinterpret_cast<char*>(values.data()), rawSize))
+	{
+		throw std::runtime_error("truncated trajectory block");
+	}
+
+	return true;
+}
+
+std::size_t TrajectoryReader::skipBlock()
+{
+	std::uint32_t recordCount, payloadSize, rawSize;
+
+	if (!_readBlockHeader(recordCount, payloadSize, rawSize))
+		return 0;
+
+	if (!_file.seekg(payloadSize, std::ios_base::cur))
+		throw std::runtime_error("truncated trajectory block");
+
+	return recordCount;
+}
+
+bool TrajectoryReader::_readBlockHeader(std::uint32_t& recordCount, std::uint32_t& payloadSize, std::uint32_t& rawSize)
+{
+	if (_isFinished)
+		return false;
+
+	// файл, оборванный без окончания (например, при аварийном завершении), читается до последнего целого блока
+	if (_file.peek() == std::ifstream::traits_type::eof())
+	{
+		_isFinished = true;
+		_closeState = TrajectoryFormat::CloseState::Forced;
+		return false;
+	}
+
+	recordCount = readValue<std::uint32_t>(_file);
+	payloadSize = readValue<std::uint32_t>(_file);
+	rawSize = readValue<std::uint32_t>(_file);
+
+	if (!recordCount)
+	{
+		_isFinished = true;
+		_closeState = static_cast<TrajectoryFormat::CloseState>(readValue<std::uint32_t>(_file));
+		return false;
+	}
+
+	return true;
+}
+
+void convertTrajectoryToCsv(const std::string& trajectoryPath, const std::string& csvPath)
+{
+	MGE_PROFILE_SCOPE(CsvExport);
+	MGE_TRACE_SCOPE("convertTrajectoryToCsv");
+	TrajectoryReader reader(trajectoryPath);
+	std::ofstream csvFile(csvPath, ios_base::out | ios_base::trunc);
+	std::vector<double> values;
+	const auto columnCount = reader.getColumnCount();
+
+	if (!csvFile.is_open())
+		throw std::runtime_error("cannot open " + csvPath);
+
+	CsvWriter csv(csvFile);
+
+	for (const auto& column : reader.getHeader().columns)
+		csv.writeField(column);
+
+	csv.endRecord();
+
+	while (reader.readBlock(values))
+	{
+		for (std::size_t i = 0; i < values.size(); i += columnCount)
+		{
+			for (std::size_t column = 0; column < columnCount; ++column)
+				csv.writeField(values[i + column], STANDARD_PRECISION);
+
+			csv.endRecord();
+		}
+	}
+
+	csv.flush();
+
+	if (reader.getCloseState() == TrajectoryFormat::CloseState::Forced)
+		csvFile << "FILE;HAS;;BEEN;;FORCIBLY;CLOSED;\n";
+}
@@ -0,0 +1,146 @@
+#include "Simulation/Recording/TrajectoryRecorder.hpp"
+#include "Simulation/Recording/BlockCodec.hpp"
+#include "Simulation/Auxilary/PhaseProfiler.hpp"
+#include "Simulation/Auxilary/TraceRecorder.hpp"
+
+#include <cstring>
+
+namespace
+{
+	template <typename T> void writeValue(std::ofstream& file, T value)
+	{
+		file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+	}
+}
+
+TrajectoryRecorder::TrajectoryRecorder(const std::string& filePath, double simResolution) : TrajectoryRecorder(filePath, simResolution, Options()) {}
+
+TrajectoryRecorder::TrajectoryRecorder(const std::string& filePath, double simResolution, const Options& options) :
+_options(options), _blockValueCount(std::max<std::size_t>(options.recordsPerBlock, 1) * TrajectoryFormat::ColumnCount)
+{
+	using namespace TrajectoryFormat;
+
+	_file.open(filePath, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+
+	if (!_file.is_open())
+		return;
+
+	_file.write(magic, sizeof(magic));
+	writeValue<std::uint16_t>(_file, version);
+	writeValue<std::uint16_t>(_file, _options.compress ? compressedFlag : 0);
+	writeValue<double>(_file, simResolution);
+	writeValue<std::uint16_t>(_file, static_cast<std::uint16_t>(columnNames().size()));
+
+	for (const auto& name : columnNames())
+	{
+		writeValue<std::uint16_t>(_file, static_cast<std::uint16_t>(name.size()));
+		_file.write(name.data(), name.size());
+	}
+
+	_currentBlock.reserve(_blockValueCount);
+	_isOpen = true;
+	_writer = std::thread([this] { _writerLoop(); });
+}
+
+TrajectoryRecorder::~TrajectoryRecorder()
+{
+	close();
+}
+
+void TrajectoryRecorder::close(TrajectoryFormat::CloseState closeState)
+{
+	if (!_isOpen)
+		return;
+
+	if (!_currentBlock.empty())
+		_submitBlock();
+
+	{
+		std::lock_guard<std::mutex> guard(_queueLock);
+		_isClosing = true;
+	}
+
+	_queueChanged.notify_all();
+	_writer.join();
+
+	writeValue<std::uint32_t>(_file, 0);
+	writeValue<std::uint32_t>(_file, 0);
+	writeValue<std::uint32_t>(_file, 0);
+	writeValue<std::uint32_t>(_file, static_cast<std::uint32_t>(closeState));
+	_file.close();
+	_isOpen = false;
+}
+
+void TrajectoryRecorder::_submitBlock()
+{
+	std::unique_lock<std::mutex> guard(_queueLock);
+
+	_queueChanged.wait(guard, [this] { return _queuedBlocks.size() < _options.maxQueuedBlocks; });
+	_queuedBlocks.push_back(std::move(_currentBlock));
+
+	if (!_spareBlocks.empty())
+	{
+		_currentBlock = std::move(_spareBlocks.back());
+		_spareBlocks.pop_back();
+	}
+
+	guard.unlock();
+	_queueChanged.notify_all();
+
+	_currentBlock.clear();
+	_currentBlock.reserve(_blockValueCount);
+}
+
+void TrajectoryRecorder::_writerLoop()
+{
+	MGE_TRACE_THREAD_NAME("TrajectoryRecorder writer");
+
+	std::vector<std::uint8_t> scratch;
+
+	while (true)
+	{
+		std::vector<double> block;
+
+		{
+			std::unique_lock<std::mutex> guard(_queueLock);
+			_queueChanged.wait(guard, [this] { return _isClosing || !_queuedBlocks.empty(); });
+
+			if (_queuedBlocks.empty())
+				return; // закрытие и очередь пуста
+
+			block = std::move(_queuedBlocks.front());
+			_queuedBlocks.pop_front();
+		}
+
+		_queueChanged.notify_all();
+		_writeBlock(block, scratch);
+
+		std::lock_guard<std::mutex> guard(_queueLock);
+		_spareBlocks.push_back(std::move(block));
+	}
+}
+
+void TrajectoryRecorder::_writeBlock(const std::vector<double>& block, std::vector<std::uint8_t>& scratch)
+{
+	MGE_PROFILE_SCOPE(TrajectoryBlockWrite);
+	MGE_TRACE_SCOPE("TrajectoryRecorder::_writeBlock");
+	const auto rawSize = block.size() * sizeof(double);
+	const auto* rawData = reinterpret_cast<const std::uint8_t*>(block.data());
+
+	writeValue<std::uint32_t>(_file, static_cast<std::uint32_t>(block.size() / TrajectoryFormat::ColumnCount));
+
+	if (_options.compress)
+	{
+		scratch.clear();
+		BlockCodec::compress(rawData, rawSize, sizeof(double), scratch);
+		writeValue<std::uint32_t>(_file, static_cast<std::uint32_t>(scratch.size()));
+		writeValue<std::uint32_t>(_file, static_cast<std::uint32_t>(rawSize));
+		_file.write(reinterpret_cast<const char*>(scratch.data()), scratch.size());
+	}
+	else
+	{
+		writeValue<std::uint32_t>(_file, static_cast<std::uint32_t>(rawSize));
+		writeValue<std::uint32_t>(_file, static_cast<std::uint32_t>(rawSize));
+		_file.write(reinterpret_cast<const char*>(rawData), rawSize);
+	}
+}
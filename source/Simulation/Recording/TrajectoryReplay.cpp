@@ -0,0 +1,65 @@
+#include "Simulation/Recording/TrajectoryReplay.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+
+TrajectoryReplay::TrajectoryReplay(const std::string& filePath) : _archive(std::make_unique<TrajectoryArchive>(prepareArchive(filePath)))
+{
+	_time = _archive->getStartTime();
+}
+
+double TrajectoryReplay::getProgress() const
+{
+	auto duration = _archive->getEndTime() - _archive->getStartTime();
+
+	return duration > 0 ? (_time - _archive->getStartTime()) / duration : 1;
+}
+
+std::size_t TrajectoryReplay::getVisibleRecordCount() const
+{
+	return _archive->findRecord(std::nextafter(_time, HUGE_VAL));
+}
+
+void TrajectoryReplay::seek(double time)
+{
+	_time = std::clamp(time, _archive->getStartTime(), _archive->getEndTime());
+}
+
+void TrajectoryReplay::play()
+{
+	if (isAtEnd())
+		_time = _archive->getStartTime();
+
+	_isPlaying = true;
+}
+
+void TrajectoryReplay::advance(double wallSeconds)
+{
+	if (!_isPlaying)
+		return;
+
+	seek(_time + wallSeconds * _speed);
+
+	if (isAtEnd())
+		_isPlaying = false;
+}
+
+std::string TrajectoryReplay::prepareArchive(const std::string& filePath)
+{
+	namespace fs = std::filesystem;
+
+	fs::path path(filePath);
+
+	if (path.extension() != ".mgtr")
+		return filePath;
+
+	auto archivePath = fs::path(path).replace_extension(".mgta");
+
+	// архив строится один раз; повторное открытие той же записи его только отображает.
+	// при равном времени изменения архив строится заново: прогон в GUI может записать файл в тот же такт часов файловой системы
+	if (!fs::exists(archivePath) || fs::last_write_time(archivePath) <= fs::last_write_time(path))
+		convertTrajectoryToArchive(path.string(), archivePath.string());
+
+	return archivePath.string();
+}
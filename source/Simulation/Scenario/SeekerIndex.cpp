@@ -0,0 +1,40 @@
+#include "Simulation/Scenario/SeekerIndex.hpp"
+
+#include <algorithm>
+
+void SeekerIndex::rebuild(const std::vector<Vec2d>& positions, const std::vector<Vec2d>& velocities, const std::vector<bool>& isIncluded, double cellSize, bool useGrid)
+{
+	_positions = &positions;
+	_velocities = &velocities;
+	_isIncluded = &isIncluded;
+	_useGrid = useGrid;
+
+	if (_useGrid)
+		_grid.rebuild(positions, isIncluded, cellSize);
+}
+
+void SeekerIndex::_getConeBounds(const Vec2d& origin, const Vec2d& boresight, double halfAngle, double range, Vec2d& minCorner, Vec2d& maxCorner)
+{
+	minCorner = maxCorner = origin;
+
+	auto include = [&](const Vec2d& point)
+	{
+		minCorner = Vec2d(std::min(minCorner.x(), point.x()), std::min(minCorner.y(), point.y()));
+		maxCorner = Vec2d(std::max(maxCorner.x(), point.x()), std::max(maxCorner.y(), point.y()));
+	};
+
+	const double cosHalfAngle = std::cos(halfAngle), sinHalfAngle = std::sin(halfAngle);
+
+	// крайние лучи сектора
+	include(origin + range * Vec2d(boresight.x() * cosHalfAngle - boresight.y() * sinHalfAngle, boresight.x() * sinHalfAngle + boresight.y() * cosHalfAngle));
+	include(origin + range * Vec2d(boresight.x() * cosHalfAngle + boresight.y() * sinHalfAngle, -boresight.x() * sinHalfAngle + boresight.y() * cosHalfAngle));
+
+	// дуга сектора выходит дальше лучей там, где пересекает направления осей
+	const Vec2d axes[] = { Vec2d(1, 0), Vec2d(-1, 0), Vec2d(0, 1), Vec2d(0, -1) };
+
+	for (const auto& axis : axes)
+	{
+		if (dot(boresight, axis) >= cosHalfAngle)
+			include(origin + range * axis);
+	}
+}
@@ -0,0 +1,303 @@
+#include "Simulation/Scenario/World.hpp"
+#include "Simulation/Auxilary/ClosestApproach.hpp"
+#include "Simulation/Auxilary/CounterRng.hpp"
+#include "Simulation/Auxilary/utils.hpp"
+
+#include <limits>
+#include <stdexcept>
+
+namespace
+{
+	constexpr double minSeekerCellSize = 1; // м
+}
+
+World::World(std::size_t missileCapacity, std::size_t targetCapacity, const WorldSettings& settings) : _settings(settings)
+{
+	_missiles.reserve(missileCapacity);
+	_targets.reserve(targetCapacity);
+}
+
+std::size_t World::addMissile(double initialSpeed, double initialX, double initialY, std::shared_ptr<const Missile::MissileDesc> desc)
+{
+	// ракеты хранят указатели на цели, поэтому хранилище не должно перевыделяться
+	if (_missiles.size() == _missiles.capacity())
+		throw std::length_error("World: missile capacity exceeded");
+
+	_missiles.emplace_back(initialSpeed, initialX, initialY, std::move(desc));
+	_isMissileActive.push_back(true);
+	_lockLostTimes.push_back(-std::numeric_limits<double>::infinity());
+	_activeMissileCount++;
+
+	return _missiles.size() - 1;
+}
+
+std::size_t World::addTarget(double initialSpeed, double initialX, double initialY, std::shared_ptr<const Target::TargetDesc> desc)
+{
+	if (_targets.size() == _targets.capacity())
+		throw std::length_error("World: target capacity exceeded");
+
+	_targets.emplace_back(initialSpeed, initialX, initialY, std::move(desc));
+	_isTargetAlive.push_back(true);
+	_aliveTargetCount++;
+
+	return _targets.size() - 1;
+}
+
+void World::iterate(double elapsedTime)
+{
+	_missileStartPositions.resize(_missiles.size());
+	_targetStartPositions.resize(_targets.size());
+	_targetEndPositions.resize(_targets.size());
+	_maxTargetStep = 0;
+
+	for (std::size_t i = 0; i < _targets.size(); ++i)
+	{
+		_targetStartPositions[i] = _targets[i].getCoordinates();
+
+		if (_isTargetAlive[i])
+			_targets[i].advancedMove(elapsedTime);
+
+		_targetEndPositions[i] = _targets[i].getCoordinates();
+		_maxTargetStep = std::max(_maxTargetStep, (_targetEndPositions[i] - _targetStartPositions[i]).length());
+	}
+
+	for (std::size_t i = 0; i < _missiles.size(); ++i)
+	{
+		_missileStartPositions[i] = _missiles[i].getCoordinates();
+
+		if (!_isMissileActive[i])
+			continue;
+
+		bool hadTarget = _missiles[i].getTarget();
+		_missiles[i].advancedMove(elapsedTime);
+
+		if (hadTarget && !_missiles[i].getTarget()) // цель вышла из ПЗ ГСН
+			_lockLostTimes[i] = _elapsedTime + elapsedTime;
+	}
+
+	_elapsedTime += elapsedTime;
+
+	_checkFuzes(elapsedTime);
+	_updateMissileActivity();
+	_acquireTargets();
+}
+
+void World::seed(std::uint64_t masterSeed)
+{
+	for (std::size_t i = 0; i < _targets.size(); ++i)
+	{
+		_targets[i].reseed(CounterRng::deriveKey(masterSeed, i));
+		_targets[i].restore(); // манёвр разыгрывается уже с новым зерном
+	}
+
+	for (std::size_t i = 0; i < _missiles.size(); ++i)
+		_missiles[i].reseed(CounterRng::deriveKey(masterSeed, _targets.size() + i));
+}
+
+void World::_acquireTargets()
+{
+	bool isIndexBuilt = false;
+
+	for (std::size_t i = 0; i < _missiles.size(); ++i)
+	{
+		if (!_isSearching(i))
+			continue;
+
+		auto& missile = _missiles[i];
+
+		if (!isIndexBuilt)
+		{
+			double maxSeekerRange = 0;
+			_targetVelocities.resize(_targets.size());
+			_engagementCounts.assign(_targets.size(), 0);
+
+			for (std::size_t t = 0; t < _targets.size(); ++t)
+				_targetVelocities[t] = _targets[t].getVelocity();
+
+			for (std::size_t m = 0; m < _missiles.size(); ++m)
+			{
+				if (_isMissileActive[m] && _missiles[m].getTarget())
+					_engagementCounts[_targetIndexOf(_missiles[m].getTarget())]++;
+
+				maxSeekerRange = std::max(maxSeekerRange, _missiles[m].getDesc().seekerRange);
+			}
+
+			// ячейка в четверть дальности ГСН: узкий сектор ПЗ задевает немного ячеек, а не весь квадрат дальности;
+			// описания, заданные в коде, не проверяются при загрузке - размер ячейки ограничен снизу
+			_seekerIndex.rebuild(_targetEndPositions, _targetVelocities, _isTargetAlive, std::max(maxSeekerRange / 4, minSeekerCellSize), _settings.useBroadphase);
+			isIndexBuilt = true;
+		}
+
+		SeekerCandidate best;
+		bool isFound = false;
+
+		_seekerIndex.forEachInCone(missile.getCoordinates(), missile.getVelocity(), degToRad(missile.getDesc().seekerMaxOBA), missile.getDesc().seekerRange,
+			[&](const SeekerCandidate& candidate)
+			{
+				if (!isFound || _isBetterCandidate(candidate, best))
+				{
+					best = candidate;
+					isFound = true;
+				}
+			});
+
+		if (isFound)
+		{
+			missile.setTarget(&_targets[best.targetIndex]);
+			_engagementCounts[best.targetIndex]++;
+		}
+	}
+}
+
+bool World::_isSearching(std::size_t missileIndex)
+{
+	if (!_isMissileActive[missileIndex] || _missiles[missileIndex].getTarget())
+		return false;
+
+	const double lockLostTime = _lockLostTimes[missileIndex];
+
+	if (lockLostTime == -std::numeric_limits<double>::infinity()) // захвата ещё не было
+		return true;
+
+	return _settings.allowReacquisition && _elapsedTime - lockLostTime >= _settings.reacquisitionDelay;
+}
+
+bool World::_isBetterCandidate(const SeekerCandidate& candidate, const SeekerCandidate& best)
+{
+	switch (_settings.selectionPolicy)
+	{
+		case TargetSelectionPolicy::SmallestOffBoresight:
+			if (candidate.offBoresight != best.offBoresight)
+				return candidate.offBoresight < best.offBoresight;
+			break;
+		case TargetSelectionPolicy::HighestClosingSpeed:
+			if (candidate.closingSpeed != best.closingSpeed)
+				return candidate.closingSpeed > best.closingSpeed;
+			break;
+		case TargetSelectionPolicy::LeastEngaged:
+			if (_engagementCounts[candidate.targetIndex] != _engagementCounts[best.targetIndex])
+				return _engagementCounts[candidate.targetIndex] < _engagementCounts[best.targetIndex];
+			break;
+		case TargetSelectionPolicy::Nearest:
+			break;
+	}
+
+	// при равенстве - ближайшая, затем меньший номер: выбор не зависит от порядка обхода сетки
+	if (candidate.distance != best.distance)
+		return candidate.distance < best.distance;
+
+	return candidate.targetIndex < best.targetIndex;
+}
+
+void World::_checkFuzes(double elapsedTime)
+{
+	double maxFuzeReach = 0;
+
+	for (std::size_t i = 0; i < _missiles.size(); ++i)
+	{
+		if (_isMissileActive[i])
+			maxFuzeReach = std::max(maxFuzeReach, _missiles[i].getProxyRadius() + (_missiles[i].getCoordinates() - _missileStartPositions[i]).length());
+	}
+
+	if (!maxFuzeReach || !_aliveTargetCount)
+		return;
+
+	// если цель прошла через зону поражения на шаге, в конце шага она не дальше радиуса плюс перемещения ракеты и цели
+	if (_settings.useBroadphase)
+		_fuzeGrid.rebuild(_targetEndPositions, _isTargetAlive, maxFuzeReach + _maxTargetStep);
+
+	for (std::size_t i = 0; i < _missiles.size(); ++i)
+	{
+		if (!_isMissileActive[i])
+			continue;
+
+		auto& missile = _missiles[i];
+		const Vec2d missileEnd = missile.getCoordinates();
+		const double proxyRadius = missile.getProxyRadius();
+		FuzeEvent event{ i, _targets.size(), 0, 0 };
+		double earliestFraction = 2;
+
+		auto consider = [&](std::size_t targetIndex)
+		{
+			if (!_isTargetAlive[targetIndex]) // цель могла быть поражена другой ракетой на этом же шаге
+				return;
+
+			Vec2d relStart = _targetStartPositions[targetIndex] - _missileStartPositions[i];
+			Vec2d relEnd = _targetEndPositions[targetIndex] - missileEnd;
+			auto approach = findClosestApproach(relStart.x(), relStart.y(), relEnd.x(), relEnd.y());
+
+			if (approach.distance > proxyRadius)
+				return;
+
+			double entryFraction = std::max(findSphereEntryFraction(relStart.x(), relStart.y(), relEnd.x(), relEnd.y(), proxyRadius), 0.);
+
+			if (entryFraction < earliestFraction)
+			{
+				earliestFraction = entryFraction;
+				event.targetIndex = targetIndex;
+				event.missDistance = approach.distance;
+			}
+		};
+
+		if (_settings.useBroadphase)
+			_fuzeGrid.forEachNear(missileEnd, proxyRadius + (missileEnd - _missileStartPositions[i]).length() + _maxTargetStep, consider);
+		else
+		{
+			for (std::size_t t = 0; t < _targets.size(); ++t)
+				consider(t);
+		}
+
+		if (event.targetIndex < _targets.size())
+		{
+			event.time = _elapsedTime - (1 - earliestFraction) * elapsedTime;
+			_fuzeEvents.push_back(event);
+			_killTarget(event.targetIndex);
+			_deactivateMissile(i);
+		}
+	}
+}
+
+void World::_deactivateMissile(std::size_t missileIndex)
+{
+	if (!_isMissileActive[missileIndex])
+		return;
+
+	_isMissileActive[missileIndex] = false;
+	_missiles[missileIndex].setTarget(nullptr);
+	_activeMissileCount--;
+}
+
+void World::_killTarget(std::size_t targetIndex)
+{
+	_isTargetAlive[targetIndex] = false;
+	_aliveTargetCount--;
+
+	// наводившиеся на поражённую цель ракеты остаются без захвата и, если разрешено, ищут новую
+	for (std::size_t i = 0; i < _missiles.size(); ++i)
+	{
+		if (_missiles[i].getTarget() == &_targets[targetIndex])
+			_loseLock(i);
+	}
+}
+
+void World::_loseLock(std::size_t missileIndex)
+{
+	_missiles[missileIndex].setTarget(nullptr);
+	_lockLostTimes[missileIndex] = _elapsedTime;
+}
+
+void World::_updateMissileActivity()
+{
+	for (std::size_t i = 0; i < _missiles.size(); ++i)
+	{
+		if (!_isMissileActive[i])
+			continue;
+
+		auto& missile = _missiles[i];
+		auto target = missile.getTarget();
+
+		// после выгорания топлива ракета полезна, пока быстрее своей цели - как и в Simulation::mslSpeedMoreThanTgtSpeed
+		if (_elapsedTime >= _settings.maxFlightTime || (missile.getRemainingFuelMass() <= 0 && (!target || missile.getSpeed() <= target->getSpeed())))
+			_deactivateMissile(i);
+	}
+}
@@ -0,0 +1,158 @@
+#include "Simulation/SimObjects/DescriptorCatalog.hpp"
+#include "Simulation/Auxilary/LuaTableParser.hpp"
+
+#include <fstream>
+#include <stdexcept>
+
+namespace
+{
+	bool fileExists(const std::string& filePath)
+	{
+		return std::ifstream(filePath).good();
+	}
+
+	Missile::MissileDesc readMissileDesc(const std::string& name, const LuaTable& table)
+	{
+		Missile::MissileDesc desc; // поля, отсутствующие в файле, сохраняют значения по умолчанию
+		auto cXData = table.getNumbers("cXData");
+		auto cXMach = table.getNumbers("cXMach");
+
+		desc.motorBurnTime = table.getNumber("motorBurnTime", desc.motorBurnTime);
+		desc.motorSpecImpulse = table.getNumber("motorSpecImpulse", desc.motorSpecImpulse);
+		desc.motorFuelMass = table.getNumber("motorFuelMass", desc.motorFuelMass);
+		desc.maxAcceleration = table.getNumber("maxNormAccel", desc.maxAcceleration);
+		desc.emptyMass = table.getNumber("emptyMass", desc.emptyMass);
+		desc.planformArea = table.getNumber("planformArea", desc.planformArea);
+		desc.DyPerDa = table.getNumber("DyPerDa", desc.DyPerDa);
+		desc.proxyFuzeRadius = table.getNumber("proxyFuzeRadius", desc.proxyFuzeRadius);
+		desc.seekerMaxOBA = table.getNumber("seekerMaxOBA", desc.seekerMaxOBA);
+		desc.seekerRange = table.getNumber("seekerRange", desc.seekerRange);
+		desc.navConstant = table.getNumber("navConstant", desc.navConstant);
+		desc.apDelay = table.getNumber("apDelay", desc.apDelay);
+
+		// по дальности ГСН строится сетка индекса целей - нулевая дальность дала бы ячейки нулевого размера
+		if (desc.seekerRange <= 0)
+			throw std::runtime_error("AAMDescs." + name + ": seekerRange must be positive");
+
+		if (!cXData.empty())
+		{
+			// без cXMach значения относятся к узлам по числу Маха таблицы по умолчанию
+			if (cXMach.empty())
+				for (const auto& [mach, cX] : desc.cXData) cXMach.push_back(mach);
+
+			if (cXMach.size() != cXData.size())
+				throw std::runtime_error("AAMDescs." + name + ": cXMach and cXData sizes differ");
+
+			desc.cXData.clear();
+
+			for (std::size_t i = 0; i < cXData.size(); ++i)
+				desc.cXData.emplace_back(cXMach[i], cXData[i]);
+
+			desc.cXTable = Missile::MissileDesc::buildZeroLiftDragTable(desc.cXData);
+		}
+
+		return desc;
+	}
+
+	Target::TargetDesc readTargetDesc(const LuaTable& table)
+	{
+		Target::TargetDesc desc;
+
+		desc.evManeuverTimeConstraints.first = table.getNumber("minEvManeuverTime", desc.evManeuverTimeConstraints.first);
+		desc.evManeuverTimeConstraints.second = table.getNumber("maxEvManeuverTime", desc.evManeuverTimeConstraints.second);
+		desc.evManeuverAccelConstraints.first = table.getNumber("minEvManeuverAccel", desc.evManeuverAccelConstraints.first);
+		desc.evManeuverAccelConstraints.second = table.getNumber("maxEvManeuverAccel", desc.evManeuverAccelConstraints.second);
+
+		return desc;
+	}
+
+	template <typename Desc, typename Reader> void readDescs(const std::string& filePath, const char* rootName, std::map<std::string, std::shared_ptr<const Desc>>& descs, Reader reader)
+	{
+		if (!fileExists(filePath))
+			return;
+
+		auto globals = parseLuaAssignmentsFile(filePath);
+
+		if (auto root = globals.getTable(rootName))
+		{
+			for (const auto& [name, value] : root->fields)
+				if (value.type == LuaValue::Type::Table) descs[name] = std::make_shared<const Desc>(reader(name, *value.table));
+		}
+	}
+}
+
+DescriptorCatalog::DescriptorCatalog()
+{
+	_missileDescs[defaultMissileName] = std::make_shared<const Missile::MissileDesc>();
+	_targetDescs[defaultTargetName] = std::make_shared<const Target::TargetDesc>();
+}
+
+void DescriptorCatalog::setDatabaseDir(const std::string& dbDir)
+{
+	_databaseDir() = dbDir;
+}
+
+const DescriptorCatalog& DescriptorCatalog::instance()
+{
+	static const DescriptorCatalog catalog = loadFrom(_databaseDir()); // потокобезопасная однократная инициализация
+
+	return catalog;
+}
+
+DescriptorCatalog DescriptorCatalog::loadFrom(const std::string& dbDir)
+{
+	DescriptorCatalog catalog;
+	auto prefix = dbDir.empty() ? std::string() : dbDir + "/";
+
+	readDescs(prefix + missileDescsFileName, "AAMDescs", catalog._missileDescs, readMissileDesc);
+	readDescs(prefix + targetDescsFileName, "TargetDescs", catalog._targetDescs, [](const std::string&, const LuaTable& table) { return readTargetDesc(table); });
+
+	return catalog;
+}
+
+std::shared_ptr<const Missile::MissileDesc> DescriptorCatalog::getMissileDesc(const std::string& name) const
+{
+	auto desc = _missileDescs.find(name);
+
+	if (desc == _missileDescs.end())
+		throw std::out_of_range("unknown missile descriptor " + name);
+
+	return desc->second;
+}
+
+std::shared_ptr<const Target::TargetDesc> DescriptorCatalog::getTargetDesc(const std::string& name) const
+{
+	auto desc = _targetDescs.find(name);
+
+	if (desc == _targetDescs.end())
+		throw std::out_of_range("unknown target descriptor " + name);
+
+	return desc->second;
+}
+
+std::vector<std::string> DescriptorCatalog::getMissileNames() const
+{
+	std::vector<std::string> names;
+
+	for (const auto& [name, desc] : _missileDescs)
+		names.push_back(name);
+
+	return names;
+}
+
+std::vector<std::string> DescriptorCatalog::getTargetNames() const
+{
+	std::vector<std::string> names;
+
+	for (const auto& [name, desc] : _targetDescs)
+		names.push_back(name);
+
+	return names;
+}
+
+std::string& DescriptorCatalog::_databaseDir()
+{
+	static std::string dbDir{ "db" };
+
+	return dbDir;
+}
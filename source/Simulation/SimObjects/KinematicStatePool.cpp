@@ -0,0 +1,63 @@
+#include "Simulation/SimObjects/KinematicStatePool.hpp"
+#include "Simulation/Auxilary/VectorRotation.hpp"
+
+#include <cmath>
+
+std::size_t KinematicStatePool::add(double x, double y, double velX, double velY, double accX, double accY)
+{
+	_columns[XColumn].push_back(x);
+	_columns[YColumn].push_back(y);
+	_columns[VelXColumn].push_back(velX);
+	_columns[VelYColumn].push_back(velY);
+	_columns[AccXColumn].push_back(accX);
+	_columns[AccYColumn].push_back(accY);
+
+	return size() - 1;
+}
+
+void KinematicStatePool::reserve(std::size_t capacity)
+{
+	for (auto& column : _columns)
+		column.reserve(capacity);
+}
+
+void KinematicStatePool::clear()
+{
+	for (auto& column : _columns)
+		column.clear();
+}
+
+void KinematicStatePool::advance(double elapsedTime)
+{
+	const std::size_t count = size();
+	const double halfSqTime = 0.5 * elapsedTime * elapsedTime;
+	double* __restrict x = data<XColumn>();
+	double* __restrict y = data<YColumn>();
+	double* __restrict velX = data<VelXColumn>();
+	double* __restrict velY = data<VelYColumn>();
+	const double* __restrict accX = data<AccXColumn>();
+	const double* __restrict accY = data<AccYColumn>();
+
+	// проходы по непрерывным массивам без ветвлений - компилятор векторизует их
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		x[i] += velX[i] * elapsedTime + accX[i] * halfSqTime;
+		y[i] += velY[i] * elapsedTime + accY[i] * halfSqTime;
+	}
+
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		velX[i] += accX[i] * elapsedTime;
+		velY[i] += accY[i] * elapsedTime;
+	}
+}
+
+void KinematicStatePool::rotate(const double* angles)
+{
+	rotateVectorsBatch(angles, data<VelXColumn>(), data<VelYColumn>(), data<AccXColumn>(), data<AccYColumn>(), size());
+}
+
+double KinematicStatePool::getSpeed(std::size_t index) const
+{
+	return std::hypot(_columns[VelXColumn][index], _columns[VelYColumn][index]);
+}
@@ -1,74 +1,143 @@
 #include "Simulation/SimObjects/Missile.hpp"
+#include "Simulation/Auxilary/PhaseProfiler.hpp"
 #include "Simulation/Auxilary/PIDController.hpp"
 #include "Simulation/Auxilary/utils.hpp"
+#include "Simulation/SimObjects/DescriptorCatalog.hpp"
 
-Missile::Missile(double initialSpeed, double initialX, double initialY) : MovingObject(initialSpeed, initialX, initialY)
+#include <limits>
+
+Missile::Missile(double initialSpeed, double initialX, double initialY, std::shared_ptr<const MissileDesc> desc) :
+MovingObject(initialSpeed, initialX, initialY), _leDesc(desc ? std::move(desc) : DescriptorCatalog::instance().getMissileDesc())
 {
 }
 
 void Missile::basicMove(double elapsedTime, double angleOfAttack)
 {
 	// изменяем скорость за счёт тяги двигателя и сопротивления воздуха
-	_actingVectors.at("velocity") += _actingVectors.at("velocity").normalized() * (elapsedTime * (_calculatePropulsionAccelerationRate() - _calculateDragDecelerationRate(angleOfAttack)));
+	_velocity() += _velocity().normalized() * (elapsedTime * (_calculatePropulsionAccelerationRate() - _calculateDragDecelerationRate(angleOfAttack)));
 
 	// изменяем состояние ракеты
-	_coordinates += _actingVectors.at("velocity") * elapsedTime;
+	_coordinates += _velocity() * elapsedTime;
 
 	// потребляем топливо
 	_remainingFuelMass -= std::min(_fuelConsumptionRate * elapsedTime, _remainingFuelMass);
 
-	_timeSinceBirth += SIM_RESOLUTION;
+	_timeSinceBirth += elapsedTime;
 }
 
 void Missile::advancedMove(double elapsedTime)
 {
+	MGE_PROFILE_SCOPE(MissileGuidance);
 	double steeringAngle = 0;
 
-	if (_acquiredTarget && _timeSinceBirth >= _leDesc.apDelay)
+	if (_isGuidanceActive())
 	{
-		QVector2D velocity = _actingVectors.at("velocity");
-		QVector2D trgLOSVec = _acquiredTarget->getCoordinates() - getCoordinates();
+		Vec2d velocity = _velocity();
+		Vec2d trgLOSVec = _acquiredTarget->getCoordinates() - getCoordinates();
 		double velLOSAngle = getAngleBetweenVectorsRad(velocity.normalized(), trgLOSVec.normalized());
 
-		if (abs(velLOSAngle) > degToRad(_leDesc.seekerMaxOBA))
+		if (std::abs(velLOSAngle) > degToRad(_leDesc->seekerMaxOBA))
 		{
 			_acquiredTarget = nullptr;
 			return;
 		}
 
-		auto angleLimit = degToRad(_leDesc.seekerMaxOBA);
-		steeringAngle = std::max(-angleLimit, std::min(degToRad(_navConstant * velLOSAngle), angleLimit));
+		steeringAngle = _calculateSteeringAngle(velLOSAngle);
 		_rotateActingVectorsRad(steeringAngle);
 	}
 
 	basicMove(elapsedTime, radToDeg(steeringAngle));
 }
 
-double Missile::_calculateDragDecelerationRate(double angleOfAttack)
+double Missile::getTimeToNextEvent()
 {
-	double zeroLiftDragCoefficient;
-	double liftInducedDragCoefficient = _calculateLiftInducedDragCoefficient(angleOfAttack); // вычисляем КИС
-	double machNumber = _calculateMachNumber(SPEED_OF_SOUND); // вычисляем число Маха
-	double fullDragForce = 0;
-	QString machNumberStr = QString::fromStdString(convertDoubleToStringWithPrecision(machNumber, 1, false));
+	double timeToEvent = std::numeric_limits<double>::infinity();
+
+	if (_acquiredTarget && _timeSinceBirth < _leDesc->apDelay)
+		timeToEvent = _leDesc->apDelay - _timeSinceBirth;
+
+	if (_remainingFuelMass > 0)
+		timeToEvent = std::min(timeToEvent, _remainingFuelMass / _fuelConsumptionRate);
+
+	return timeToEvent;
+}
 
-	if (_leDesc.cXData.contains(machNumberStr))
+Missile::State Missile::getDerivative(const State& state, double targetX, double targetY)
+{
+	const auto& [x, y, vX, vY, fuelMass] = state;
+	double speed = std::hypot(vX, vY);
+	double rangeToTarget = std::hypot(targetX - x, targetY - y);
+	double dirX = 0, dirY = 0;
+	double turnRate = 0;
+
+	// при нулевой скорости направление не определено - тяга считается направленной на цель
+	if (speed > 0)
 	{
-		zeroLiftDragCoefficient = _leDesc.cXData.value(machNumberStr);
+		dirX = vX / speed;
+		dirY = vY / speed;
 	}
-	else
+	else if (rangeToTarget > 0)
 	{
-		zeroLiftDragCoefficient = _interpolateZeroLiftDragCoefficient(machNumber);
+		dirX = (targetX - x) / rangeToTarget;
+		dirY = (targetY - y) / rangeToTarget;
+	}
+
+	if (_isGuidanceActive())
+	{
+		double velLOSAngle = getAngleBetweenVectorsRad(vX, vY, targetX - x, targetY - y);
+
+		// доворот за такт SIM_RESOLUTION в методе Эйлера соответствует угловой скорости steeringAngle / SIM_RESOLUTION
+		turnRate = _calculateSteeringAngle(velLOSAngle) / SIM_RESOLUTION;
 	}
 
-	fullDragForce = _calculateDynPressure() * (zeroLiftDragCoefficient + liftInducedDragCoefficient); // вычисляем полную силу сопротивления воздуха
+	// продольное ускорение - тяга минус сопротивление, поперечное - центростремительное при развороте вектора скорости
+	double longAcc = _calculatePropulsionAccelerationRate(fuelMass) - _calculateDragDecelerationRate(radToDeg(turnRate * SIM_RESOLUTION), speed, fuelMass);
+	double latAcc = turnRate * speed;
 
-	return fullDragForce / _calculateTotalMass(); // вычисляем "торможение", вызванное силой сопротивления воздуха
+	return { vX, vY, longAcc * dirX - latAcc * dirY, longAcc * dirY + latAcc * dirX, fuelMass > 0 ? -_fuelConsumptionRate : 0 };
+}
+
+void Missile::setState(const State& state, double elapsedTime)
+{
+	const auto& [x, y, vX, vY, fuelMass] = state;
+
+	_coordinates = Vec2d(x, y);
+	_velocity() = Vec2d(vX, vY);
+	_remainingFuelMass = std::max(fuelMass, 0.);
+	_timeSinceBirth += elapsedTime;
+}
+
+void Missile::updateSeekerLock()
+{
+	if (!_isGuidanceActive())
+		return;
+
+	Vec2d trgLOSVec = _acquiredTarget->getCoordinates() - getCoordinates();
+
+	if (std::abs(getAngleBetweenVectorsRad(_velocity().normalized(), trgLOSVec.normalized())) > degToRad(_leDesc->seekerMaxOBA))
+		_acquiredTarget = nullptr;
+}
+
+double Missile::_calculateSteeringAngle(double velLOSAngle)
+{
+	auto angleLimit = degToRad(_leDesc->seekerMaxOBA);
+
+	return std::max(-angleLimit, std::min(degToRad(_navConstant * velLOSAngle), angleLimit));
+}
+
+double Missile::_calculateDragDecelerationRate(double angleOfAttack, double speed, double fuelMass)
+{
+	MGE_PROFILE_SCOPE(MissileDrag);
+	double zeroLiftDragCoefficient = _interpolateZeroLiftDragCoefficient(_calculateMachNumber(speed, SPEED_OF_SOUND)); // вычисляем КСФ по числу Маха
+	double liftInducedDragCoefficient = _calculateLiftInducedDragCoefficient(angleOfAttack); // вычисляем КИС
+	double fullDragForce = _calculateDynPressure(speed) * (zeroLiftDragCoefficient + liftInducedDragCoefficient); // вычисляем полную силу сопротивления воздуха
+
+	return fullDragForce / _calculateTotalMass(fuelMass); // вычисляем "торможение", вызванное силой сопротивления воздуха
 }
 
 void Missile::_setGuidanceBoundary()
 {
-	double maxNormalForce = _calculateTotalMass() * _leDesc.maxAcceleration * FREEFALL_ACC; // вычисляем максимальную поперечную силу "торможения"
+	double maxNormalForce = _calculateTotalMass() * _leDesc->maxAcceleration * FREEFALL_ACC; // вычисляем максимальную поперечную силу "торможения"
 	double inducedDragCoeffAtMaxDecel;
 	double maxAoA;
 
@@ -80,38 +149,12 @@ void Missile::_setGuidanceBoundary()
 	_guidanceComputer->setMaxBoundary(maxAoA);
 }
 
-double Missile::_interpolateZeroLiftDragCoefficient(double machNumber)
+UniformLookupTable Missile::MissileDesc::buildZeroLiftDragTable(const std::vector<std::pair<double, double>>& cXData)
 {
-	double interpolatedCoefficient = 0.01;
+	const static double machStep{ 0.01 }; // узлы таблицы кратны шагу, поэтому пересчёт не искажает кусочно-линейную кривую
+	std::vector<std::pair<double, double>> knots{ { 0., 0. } }; // ниже первого узла КСФ линейно спадает к нулю при M = 0
 
-	if (machNumber < 0.5)
-	{
-		interpolatedCoefficient = lerp(machNumber, 0, 0, 0.5, _leDesc.cXData.value("0.5"));
-	}
-	else if (machNumber < 0.9)
-	{
-		interpolatedCoefficient = lerp(machNumber, 0.5, _leDesc.cXData.value("0.5"), 0.9, _leDesc.cXData.value("0.9"));
-	}
-	else if (machNumber < 1.2)
-	{
-		interpolatedCoefficient = lerp(machNumber, 0.9, _leDesc.cXData.value("0.9"), 1.2, _leDesc.cXData.value("1.2"));
-	}
-	else if (machNumber < 1.5)
-	{
-		interpolatedCoefficient = lerp(machNumber, 1.2, _leDesc.cXData.value("1.2"), 1.5, _leDesc.cXData.value("1.5"));
-	}
-	else if (machNumber < 2.0)
-	{
-		interpolatedCoefficient = lerp(machNumber, 1.5, _leDesc.cXData.value("1.5"), 2.0, _leDesc.cXData.value("2.0"));
-	}
-	else if (machNumber < 3.0)
-	{
-		interpolatedCoefficient = lerp(machNumber, 2.0, _leDesc.cXData.value("2.0"), 3.0, _leDesc.cXData.value("3.0"));
-	}
-	else if (machNumber < 4.0)
-	{
-		interpolatedCoefficient = lerp(machNumber, 3.0, _leDesc.cXData.value("3.0"), 4.0, _leDesc.cXData.value("4.0"));
-	}
+	knots.insert(knots.end(), cXData.begin(), cXData.end());
 
-	return interpolatedCoefficient;
+	return UniformLookupTable(std::move(knots), machStep);
 }
@@ -1,47 +1,87 @@
 #include "Simulation/CommonSimParams.hpp"
 #include "Simulation/SimObjects/Target.hpp"
+#include "Simulation/Auxilary/PhaseProfiler.hpp"
 #include "Simulation/Auxilary/utils.hpp"
+#include "Simulation/SimObjects/DescriptorCatalog.hpp"
 
-namespace TargetParameters
-{
-	constexpr std::pair<double, double> evManeuverTimeConstraints{ 0.5, 30. };	// мин/макс время следования с ускорением для цели
-	constexpr std::pair<double, double> evManeuverAccelConstraints{ -9., 9. };	// мин/макс поперечное ускорение цели
-};
+#include <limits>
 
-Target::Target(double initialSpeed, double initialX, double initialY) : MovingObject(-initialSpeed, initialX, initialY)
+Target::Target(double initialSpeed, double initialX, double initialY, std::shared_ptr<const TargetDesc> desc) :
+MovingObject(-initialSpeed, initialX, initialY), _leDesc(desc ? std::move(desc) : DescriptorCatalog::instance().getTargetDesc())
 {
-	_actingVectors.try_emplace("acceleration", QVector2D(0, 0)); // создаём вектор ускорения
+	_usedActingVectorSlots = ActingVectorSlotCount; // задействуем вектор ускорения
 
 	_setUpAccelerationParameters();
 }
 
 double Target::getAccelerationRate()
 {
-	return _actingVectors.at("acceleration").length();
+	return _acceleration().length();
 }
 
 void Target::basicMove(double elapsedTime)
 {
-	QVector2D positionDelta = _actingVectors.at("velocity") * elapsedTime;
+	Vec2d positionDelta = _velocity() * elapsedTime;
 
-	if (_actingVectors.at("acceleration").length())
-		 positionDelta += _actingVectors.at("acceleration") * pow(elapsedTime, 2) * FREEFALL_ACC * 0.5;
+	if (_acceleration().length())
+		 positionDelta += _acceleration() * pow(elapsedTime, 2) * FREEFALL_ACC * 0.5;
 
-	_rotateActingVectorsRad(getAngleBetweenVectorsRad(positionDelta.normalized(), _actingVectors.at("velocity").normalized()));
+	// хорда дуги отклонена от начальной скорости на половину угла поворота за шаг
+	_rotateActingVectorsRad(2 * getAngleBetweenVectorsRad(_velocity().normalized(), positionDelta.normalized()));
 
 	_coordinates += positionDelta;
-	_timeSinceBirth += SIM_RESOLUTION;
+	_timeSinceBirth += elapsedTime;
+}
+
+double Target::getTimeToManeuverChange()
+{
+	return _isEvasiveActionRequired ? std::max(_timeToProceedWithAcceleration - _timeSinceAccelerationChange, 0.) : std::numeric_limits<double>::infinity();
+}
+
+Target::State Target::getDerivative(const State& state)
+{
+	const auto& [x, y, vX, vY] = state;
+	double speed = std::hypot(vX, vY);
+
+	// без скорости нет направления, относительно которого действует поперечное ускорение
+	if (speed <= 0 || getSpeed() <= 0)
+		return { vX, vY, 0, 0 };
+
+	double dirX = vX / speed, dirY = vY / speed;
+	// поперечная составляющая ускорения поворачивается вместе со скоростью, модуль скорости не меняется
+	double latAcc = (_acceleration().y() * _velocity().x() - _acceleration().x() * _velocity().y()) / getSpeed() * FREEFALL_ACC;
+
+	return { vX, vY, -latAcc * dirY, latAcc * dirX };
+}
+
+void Target::setState(const State& state, double elapsedTime)
+{
+	const auto& [x, y, vX, vY] = state;
+	Vec2d newVelocity(vX, vY);
+
+	rotateVec(getAngleBetweenVectorsRad(_velocity().normalized(), newVelocity.normalized()), _acceleration());
+
+	_coordinates = Vec2d(x, y);
+	_velocity() = newVelocity;
+	_timeSinceBirth += elapsedTime;
+
+	_advanceManeuverTimer(elapsedTime);
 }
 
 void Target::setAccelerationRate(double newAccelerationRate)
 {
-	_actingVectors.at("acceleration").setX(newAccelerationRate);
+	_acceleration().setX(newAccelerationRate);
 }
 
 void Target::advancedMove(double elapsedTime)
 {
+	MGE_PROFILE_SCOPE(TargetManeuver);
 	basicMove(elapsedTime);
+	_advanceManeuverTimer(elapsedTime);
+}
 
+void Target::_advanceManeuverTimer(double elapsedTime)
+{
 	if (_isEvasiveActionRequired)
 	{
 		_timeSinceAccelerationChange += elapsedTime;
@@ -51,14 +91,15 @@ void Target::advancedMove(double elapsedTime)
 	}
 }
 
-inline void Target::_setUpAccelerationParameters()
+void Target::_setUpAccelerationParameters()
 {
 	if (_isEvasiveActionRequired)
 	{
-		using namespace TargetParameters;
+		const auto& [minTime, maxTime] = _leDesc->evManeuverTimeConstraints;
+		const auto& [minAccel, maxAccel] = _leDesc->evManeuverAccelConstraints;
 
 		_timeSinceAccelerationChange = 0;
-		_timeToProceedWithAcceleration = _getRandomInRange(evManeuverTimeConstraints.first, evManeuverTimeConstraints.second);	// задаём случайное время следования с новым ускорением
-		setAccelerationRate(_getRandomInRange(evManeuverAccelConstraints.first, evManeuverAccelConstraints.second));			// меняем ускорение
+		_timeToProceedWithAcceleration = _getRandomInRange(minTime, maxTime);	// задаём случайное время следования с новым ускорением
+		setAccelerationRate(_getRandomInRange(minAccel, maxAccel));				// меняем ускорение
 	}
 }
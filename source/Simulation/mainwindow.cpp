@@ -1,11 +1,49 @@
 #include "Simulation/mainwindow.h"
 #include "Simulation/CommonSimParams.hpp"
+#include "Simulation/Auxilary/PhaseProfiler.hpp"
+#include "Simulation/Auxilary/TraceRecorder.hpp"
+#include "Simulation/Auxilary/VectorRotation.hpp"
 #include "./ui_mainwindow.h"
 
+#include <QFileDialog>
+#include <random>
+
+namespace
+{
+	// зерно, введённое пользователем, или новое случайное, если поле пусто или не содержит числа
+	std::uint64_t getRunSeed(const QString& text)
+	{
+		bool isValid = false;
+		auto seed = text.trimmed().toULongLong(&isValid);
+
+		if (isValid)
+			return seed;
+
+		std::random_device device;
+
+		return (std::uint64_t(device()) << 32) | device();
+	}
+
+	// записи [first, last) дописываются в контейнер графика одним куском, без пересоздания уже показанных точек;
+	// контейнер принимает только QCPGraphData, поэтому столбцы архива перекладываются в вектор из одних новых записей
+	void appendReplayChunk(QCPGraph* graph, const double* keys, const double* values, std::size_t first, std::size_t last)
+	{
+		QVector<QCPGraphData> chunk(int(last - first));
+
+		for (std::size_t i = first; i < last; ++i)
+			chunk[int(i - first)] = QCPGraphData(keys[i], values[i]);
+
+		graph->data()->add(chunk, false);
+	}
+}
+
 MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent), ui(new Ui::MainWindow)
 {
+	MGE_TRACE_THREAD_NAME("GUI");
 	ui->setupUi(this);
 	setWindowIcon(QIcon(":/icons/icon.ico"));
+	runSeedLabel = new QLabel(this);
+	ui->statusbar->addPermanentWidget(runSeedLabel);
 	_leSim = new Simulation();
 
 	radiusCurve = new QCPCurve(ui->plot->xAxis, ui->plot->yAxis);
@@ -19,6 +57,14 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent), ui(new Ui::MainWi
 	radCrvCasted->setName("Missile Proximity Radius");
 	radCrvCasted->setAntialiased(true);
 
+	envelopeMap = new QCPColorMap(ui->plot->xAxis, ui->plot->yAxis);
+	auto envMapCasted = static_cast<QCPColorMap*>(envelopeMap);
+	envMapCasted->setGradient(QCPColorGradient::gpJet);
+	envMapCasted->setInterpolate(false);
+	envMapCasted->setName("Rmax");
+	envMapCasted->setVisible(false);
+	envMapCasted->removeFromLegend();
+
 	ui->plot->legend->setVisible(true);
 
 	ui->plot->addGraph()->setName("Missile");
@@ -34,7 +80,12 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent), ui(new Ui::MainWi
 
 	ui->plot->setInteractions(QCP::iRangeDrag | QCP::iRangeZoom);
 
-	std::thread dataPrepThread([&]{ prepareHitRadData(); });
+	replotTimer.setInterval(REPLOT_INTERVAL_MS);
+	connect(&replotTimer, &QTimer::timeout, this, &MainWindow::onReplotTimerTimeout);
+	replayTimer.setInterval(REPLOT_INTERVAL_MS);
+	connect(&replayTimer, &QTimer::timeout, this, &MainWindow::onReplayTimerTimeout);
+
+	std::thread dataPrepThread([&]{ MGE_TRACE_THREAD_NAME("dataPrepThread"); prepareHitRadData(); });
 	dataPrepThread.detach();
 
 	_createLangMenu();
@@ -42,17 +93,30 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent), ui(new Ui::MainWi
 
 MainWindow::~MainWindow()
 {
+	simCancelRequested = true;
+	if (simThread.joinable()) simThread.join();
+	if (envelopeThread.joinable()) envelopeThread.join();
+	if (replayPrepThread.joinable()) replayPrepThread.join();
 	delete ui;
 	delete _leSim;
 }
 
 void MainWindow::on_startSimBtn_clicked()
 {
+	if (isJobRunning())
+		return;
+
 	auto leTgt = _leSim->getTarget();
 	auto leMsl = _leSim->getMissile();
 	
+	stopReplay();
 	_leSim->setFileOutputNeededTo(ui->fileOCheckBox->isChecked());
 	_leSim->restoreSimState();
+
+	// цель и ракета получают собственные потоки ГСЧ из общего зерна - то же зерно в пакетном прогоне даёт тот же манёвр цели
+	auto runSeed = getRunSeed(ui->seedLineEdit->text());
+	_leSim->seed(runSeed);
+	runSeedLabel->setText(tr("Seed: %1").arg(runSeed));
 	
 	leTgt->setCoords(0, ui->distanceSpinBox->value());
 	leTgt->setVelocity(0, -ui->tgtSpeedSpinBox->value());
@@ -67,32 +131,37 @@ void MainWindow::on_startSimBtn_clicked()
 	ui->outputLabel->setStyleSheet("QLabel { color: black; text-align: center; }");
 
 	if (radiusCurve) static_cast<QCPCurve*>(radiusCurve)->setVisible(false);
+	showTrajectoryView();
 
-	float tSinceReplot = 0;
 	simFinished = false;
+	simCancelRequested = false;
+	simProgressTime = 0;
+	simProgressDistance = _leSim->getMslTgtDistance();
 
-	mslX.clear(); mslY.clear();
-	tgtX.clear(); tgtY.clear();
-	tgtX.append(_leSim->getTarget()->getX());
-	tgtY.append(_leSim->getTarget()->getY());
-	mslX.append(_leSim->getMissile()->getX());
-	mslY.append(_leSim->getMissile()->getY());
+	clearTrajectory();
+	appendTrajectorySample({ _leSim->getMissile()->getX(), _leSim->getMissile()->getY(), _leSim->getTarget()->getX(), _leSim->getTarget()->getY() });
 	plot();
-	
-	std::thread simThread([&]{ runSim(); });
-	simThread.detach();
 
-	while (!simFinished)
-	{
-		if (tSinceReplot >= 0.5)
-		{
-			tSinceReplot = 0;
-			plot();
-		}
+	simRunning = true;
+	updateJobButtons();
+	_leSim->startFileOutput();
 
-		tSinceReplot += SIM_RESOLUTION;
+	// моделирование идёт в отдельном потоке, GUI перерисовывается по таймеру и остаётся отзывчивым
+	simThread = std::thread([this]{ MGE_TRACE_THREAD_NAME("simThread"); runSim(); });
+	replotTimer.start();
+}
+
+void MainWindow::onReplotTimerTimeout()
+{
+	if (!simFinished)
+	{
+		ui->outputLabel->setText(tr("Simulation's running: %1 s elapsed, %2 m to the target").arg(simProgressTime.load(), 0, 'f', 1).arg(simProgressDistance.load(), 0, 'f', 0));
+		plot();
+		return;
 	}
 
+	finishSim();
+
 	if (_leSim->mslWithinTgtHitRadius())
 	{
 		ui->outputLabel->setText(tr("Simulation's been stopped: the missile has reached the target"));
@@ -105,50 +174,352 @@ void MainWindow::on_startSimBtn_clicked()
 	}
 
 	plot(true);
+
+	auto mslStats = mslPoints.getStats();
+	auto tgtStats = tgtPoints.getStats();
+
+	// насколько верна оценка запаса: сегменты сверх неё выделялись по ходу, но уже записанные точки не копировались
+	auto statusMessage = tr("Trajectory buffers: %1 + %2 points, %3 segments reserved, %4 grown during the run")
+		.arg(mslStats.size).arg(tgtStats.size).arg(mslStats.reservedSegments + tgtStats.reservedSegments).arg(mslStats.grownSegments + tgtStats.grownSegments);
+
+	if (traceDroppedEvents)
+		statusMessage += tr("; trace: %1 events dropped over the per-thread limit").arg(traceDroppedEvents);
+
+	ui->statusbar->showMessage(statusMessage);
+}
+
+void MainWindow::finishSim()
+{
+	if (!simRunning)
+		return;
+
+	replotTimer.stop();
+
+	if (simThread.joinable()) simThread.join();
+
+	// у каждого прогона своя законченная запись - её можно сразу открыть для воспроизведения
+	_leSim->finishFileOutput(simCancelRequested ? TrajectoryFormat::CloseState::Forced : TrajectoryFormat::CloseState::Normal);
+
+#ifdef MGE_PROFILER
+	{
+		std::ofstream profileReport(PROFILE_REPORT_FILE_NAME, ios_base::out | ios_base::trunc);
+		PhaseProfiler::report(profileReport);
+		PhaseProfiler::reset(); // поток записи траектории может ещё дописывать блоки - сброс это допускает
+	}
+#endif
+#ifdef MGE_TRACE
+	// в файле только этот прогон: после сохранения события сбрасываются, память завершившихся потоков освобождается
+	TraceRecorder::saveChromeTrace(TRACE_FILE_NAME);
+	traceDroppedEvents = TraceRecorder::getDroppedEventCount();
+	TraceRecorder::reset();
+#endif
+
+	simRunning = false;
+	updateJobButtons();
+}
+
+void MainWindow::updateJobButtons()
+{
+	auto isIdle = !isJobRunning();
+
+	ui->startSimBtn->setEnabled(isIdle);
+	ui->envelopeBtn->setEnabled(isIdle);
+	ui->openReplayBtn->setEnabled(isIdle);
 }
 
 void MainWindow::on_resetSimBtn_clicked()
 {
-	mslX.clear(); mslY.clear();
-	tgtX.clear(); tgtY.clear();
+	// прерываем идущее моделирование
+	simCancelRequested = true;
+	finishSim();
+	stopReplay();
+
+	trajectoryChannel.drain([](const TrajectorySample&) {}); // отбрасываем незабранные точки
+	clearTrajectory();
 	ui->outputLabel->clear();
 	_leSim->restoreSimState();
 	if (radiusCurve) static_cast<QCPCurve*>(radiusCurve)->setVisible(false);
+	showTrajectoryView();
 	simFinished = false;
 
 	plot();
 }
 
-void MainWindow::plot(bool doFilter)
+void MainWindow::on_envelopeBtn_clicked()
 {
-	if (doFilter)
+	if (isJobRunning())
+		return;
+
+	// прежний поток уже передал результат и завершается - ожидание не блокирует GUI
+	if (envelopeThread.joinable()) envelopeThread.join();
+
+	stopReplay();
+
+	const static std::size_t axisSteps{ 12 };
+	EnvelopeGrid grid;
+	double tgtSpeed = ui->tgtSpeedSpinBox->value();
+	double mslSpeed = ui->mslSpeedSpinBox->value();
+
+	// сетка скоростей от половины до удвоенного заданного значения, постоянная наведения - заданная
+	grid.targetSpeeds = EnvelopeGrid::linspace(std::max(tgtSpeed / 2, 10.), std::max(tgtSpeed * 2, 20.), axisSteps);
+	grid.missileSpeeds = EnvelopeGrid::linspace(std::max(mslSpeed / 2, 10.), std::max(mslSpeed * 2, 20.), axisSteps);
+	grid.navConstants = { ui->navConstDoubleSpinBox->value() };
+	grid.maxDistance = std::max(100000., 2. * ui->distanceSpinBox->value());
+
+	envelopeRunning = true;
+	updateJobButtons();
+	ui->outputLabel->setText(tr("Computing the launch envelope; please wait"));
+	ui->outputLabel->setStyleSheet("QLabel { color: black; text-align: center; }");
+
+	// зона пуска считается в фоне, результат передаётся в поток GUI через очередь событий
+	envelopeThread = std::thread([this, grid]
+	{
+		MGE_TRACE_THREAD_NAME("envelopeThread");
+		MGE_TRACE_SCOPE("EnvelopeSweep::run");
+		auto result = EnvelopeSweep(grid).run();
+		QMetaObject::invokeMethod(this, [this, result] { showEnvelope(result); }, Qt::QueuedConnection);
+	});
+}
+
+void MainWindow::showEnvelope(const EnvelopeResult& result)
+{
+	envelopeRunning = false;
+
+	const auto& grid = result.grid;
+	auto envMapCasted = static_cast<QCPColorMap*>(envelopeMap);
+	auto values = result.heatmap(EnvelopeResult::Metric::RMax, 0);
+	auto [minRange, maxRange] = std::minmax_element(values.begin(), values.end());
+
+	envMapCasted->data()->setSize(int(grid.targetSpeeds.size()), int(grid.missileSpeeds.size()));
+	envMapCasted->data()->setRange(QCPRange(grid.targetSpeeds.front(), grid.targetSpeeds.back()), QCPRange(grid.missileSpeeds.front(), grid.missileSpeeds.back()));
+
+	for (std::size_t missileIndex = 0; missileIndex < grid.missileSpeeds.size(); ++missileIndex)
+		for (std::size_t targetIndex = 0; targetIndex < grid.targetSpeeds.size(); ++targetIndex)
+			envMapCasted->data()->setCell(int(targetIndex), int(missileIndex), values[missileIndex * grid.targetSpeeds.size() + targetIndex]);
+
+	ui->plot->graph(0)->setVisible(false);
+	ui->plot->graph(1)->setVisible(false);
+	static_cast<QCPCurve*>(radiusCurve)->setVisible(false);
+	ui->plot->legend->setVisible(false);
+	envMapCasted->setVisible(true);
+	envMapCasted->rescaleDataRange(true);
+	ui->plot->xAxis->setLabel(tr("Target Speed (m/s)"));
+	ui->plot->yAxis->setLabel(tr("Missile Initial Velocity (m/s)"));
+	ui->plot->rescaleAxes(true); // только по видимым: скрытые траектории в метрах не должны растягивать оси скоростей
+	ui->plot->replot();
+
+	ui->outputLabel->setText(tr("Launch envelope: Rmax from %1 to %2 m over %3 engagements").arg(*minRange, 0, 'f', 0).arg(*maxRange, 0, 'f', 0).arg(result.getTotalRunCount()));
+	updateJobButtons();
+}
+
+void MainWindow::showTrajectoryView()
+{
+	if (envelopeMap) static_cast<QCPColorMap*>(envelopeMap)->setVisible(false);
+
+	ui->plot->graph(0)->setVisible(true);
+	ui->plot->graph(1)->setVisible(true);
+	ui->plot->legend->setVisible(true);
+	ui->plot->xAxis->setLabel(QString());
+	ui->plot->yAxis->setLabel(QString());
+}
+
+void MainWindow::on_openReplayBtn_clicked()
+{
+	if (isJobRunning())
+		return;
+
+	auto filePath = QFileDialog::getOpenFileName(this, tr("Open Recording"), QString(), tr("Trajectory recordings (*.mgtr *.mgta)"));
+
+	if (filePath.isEmpty())
+		return;
+
+	// прежний поток уже передал результат и завершается - ожидание не блокирует GUI
+	if (replayPrepThread.joinable()) replayPrepThread.join();
+
+	stopReplay();
+
+	replayPreparing = true;
+	updateJobButtons();
+	ui->outputLabel->setText(tr("Preparing the recording; please wait"));
+	ui->outputLabel->setStyleSheet("QLabel { color: black; text-align: center; }");
+
+	// запись .mgtr перекладывается в архив в фоне, открывается готовый архив уже в потоке GUI
+	replayPrepThread = std::thread([this, path = filePath.toStdString()]
 	{
-		auto filterData = [&](QVector<double>& keyVec, QVector<double>& valVec)
+		MGE_TRACE_THREAD_NAME("replayPrepThread");
+		std::string archivePath;
+		QString error;
+
+		try
+		{
+			archivePath = TrajectoryReplay::prepareArchive(path);
+		}
+		catch (const std::exception& e)
 		{
-			auto filterInterval = _leSim->getMissile()->getProxyRadius() * 5;
-			
-			if (keyVec.size() <= 1)
-				return;
+			error = e.what();
+		}
 
-			for (auto i = 5; i < keyVec.size() - 5; ++i) // don't filter some initial and some final points
-			{
-				auto pointDist = sqrt(pow(keyVec.at(i) - keyVec.at(i - 1), 2) + pow(valVec.at(i) - valVec.at(i - 1), 2));
-				if (pointDist < filterInterval)
-				{
-					keyVec.remove(i);
-					valVec.remove(i);
-					i--;
-				}
-			}
-		};
+		QMetaObject::invokeMethod(this, [this, archivePath, error] { openReplay(archivePath, error); }, Qt::QueuedConnection);
+	});
+}
+
+void MainWindow::openReplay(const std::string& archivePath, QString error)
+{
+	replayPreparing = false;
+	updateJobButtons();
+
+	if (error.isEmpty())
+	{
+		try
+		{
+			replay = std::make_unique<TrajectoryReplay>(archivePath);
+		}
+		catch (const std::exception& e)
+		{
+			error = e.what();
+		}
+	}
+
+	if (!error.isEmpty())
+	{
+		ui->outputLabel->setText(tr("Cannot open the recording: %1").arg(error));
+		ui->outputLabel->setStyleSheet("QLabel { color: red; text-align: center; }");
+		return;
+	}
+
+	ui->outputLabel->clear();
+
+	replay->setSpeed(ui->replaySpeedSpinBox->value());
+	replay->seekProgress(1);
+	replayShownCount = 0;
+
+	clearTrajectory();
+	if (radiusCurve) static_cast<QCPCurve*>(radiusCurve)->setVisible(false);
+	showTrajectoryView();
+	ui->plot->graph(0)->data()->clear();
+	ui->plot->graph(1)->data()->clear();
+	ui->outputLabel->setStyleSheet("QLabel { color: black; text-align: center; }");
+	ui->playReplayBtn->setEnabled(true);
+	ui->replaySlider->setEnabled(true);
+
+	// сначала показывается весь перехват - по нему выставляются оси, дальше они не прыгают при перемотке
+	showReplayFrame();
+	ui->plot->rescaleAxes(true);
+	ui->plot->xAxis->setScaleRatio(ui->plot->yAxis, 1);
+	ui->plot->yAxis->setScaleRatio(ui->plot->xAxis, 1);
+	ui->plot->replot();
+}
+
+void MainWindow::on_playReplayBtn_clicked()
+{
+	if (!replay)
+		return;
+
+	if (replay->isPlaying())
+	{
+		replay->pause();
+		replayTimer.stop();
+		ui->playReplayBtn->setText(tr("Play"));
+		return;
+	}
+
+	replay->play();
+	replayClock.start();
+	replayTimer.start();
+	ui->playReplayBtn->setText(tr("Pause"));
+	showReplayFrame();
+}
+
+void MainWindow::on_replaySlider_valueChanged(int value)
+{
+	if (!replay)
+		return;
+
+	replay->seekProgress(double(value) / ui->replaySlider->maximum());
+	showReplayFrame();
+}
+
+void MainWindow::on_replaySpeedSpinBox_valueChanged(double value)
+{
+	if (replay)
+		replay->setSpeed(value);
+}
+
+void MainWindow::onReplayTimerTimeout()
+{
+	replay->advance(replayClock.restart() / 1000.);
+	showReplayFrame();
+
+	if (!replay->isPlaying())
+	{
+		replayTimer.stop();
+		ui->playReplayBtn->setText(tr("Play"));
+	}
+}
+
+void MainWindow::showReplayFrame()
+{
+	MGE_TRACE_SCOPE("MainWindow::showReplayFrame");
+	using TrajectoryFormat::Column;
 
-		filterData(mslX, mslY);
-		filterData(tgtX, tgtY);
+	const auto& archive = replay->getArchive();
+	auto visibleCount = replay->getVisibleRecordCount();
+
+	// вперёд - дописываются только новые записи, назад - графики собираются заново с начала записи
+	if (visibleCount < replayShownCount)
+	{
+		ui->plot->graph(0)->data()->clear();
+		ui->plot->graph(1)->data()->clear();
+		replayShownCount = 0;
 	}
 
-	ui->plot->graph(0)->setData(mslX, mslY);
-	ui->plot->graph(1)->setData(tgtX, tgtY);
-	ui->plot->rescaleAxes();
+	if (visibleCount > replayShownCount)
+	{
+		appendReplayChunk(ui->plot->graph(0), archive.getColumn(Column::MissileX), archive.getColumn(Column::MissileY), replayShownCount, visibleCount);
+		appendReplayChunk(ui->plot->graph(1), archive.getColumn(Column::TargetX), archive.getColumn(Column::TargetY), replayShownCount, visibleCount);
+		replayShownCount = visibleCount;
+	}
+
+	{
+		QSignalBlocker sliderBlocker(ui->replaySlider);
+		ui->replaySlider->setValue(int(std::lround(replay->getProgress() * ui->replaySlider->maximum())));
+	}
+
+	if (visibleCount)
+	{
+		auto last = visibleCount - 1;
+		auto distance = std::hypot(archive.getValue(Column::MissileX, last) - archive.getValue(Column::TargetX, last), archive.getValue(Column::MissileY, last) - archive.getValue(Column::TargetY, last));
+
+		ui->outputLabel->setText(tr("Replay: %1 s of %2 s, %3 m to the target").arg(replay->getTime(), 0, 'f', 2).arg(archive.getEndTime(), 0, 'f', 2).arg(distance, 0, 'f', 0));
+	}
+
+	ui->plot->replot(QCustomPlot::rpQueuedReplot);
+}
+
+void MainWindow::stopReplay()
+{
+	replayTimer.stop();
+	replay.reset();
+	ui->playReplayBtn->setText(tr("Play"));
+	ui->playReplayBtn->setEnabled(false);
+	ui->replaySlider->setEnabled(false);
+}
+
+void MainWindow::plot(bool doFilter)
+{
+	MGE_TRACE_SCOPE("MainWindow::plot");
+	drainTrajectoryChannel();
+
+	if (doFilter)
+	{
+		// моделирование окончено - отдаём последние точки, конечная точка траектории сохраняется
+		mslDecimator.finish([this](double x, double y) { mslPoints.push_back(Vec2d(x, y)); });
+		tgtDecimator.finish([this](double x, double y) { tgtPoints.push_back(Vec2d(x, y)); });
+	}
+
+	appendGraphData(ui->plot->graph(0), mslPoints, mslDecimator, mslShown);
+	appendGraphData(ui->plot->graph(1), tgtPoints, tgtDecimator, tgtShown);
+	ui->plot->rescaleAxes(true);
 	ui->plot->xAxis->setScaleRatio(ui->plot->yAxis, 1);
 	ui->plot->yAxis->setScaleRatio(ui->plot->xAxis, 1);
 	ui->plot->graph(0)->setAdaptiveSampling(true);
@@ -156,59 +527,165 @@ void MainWindow::plot(bool doFilter)
 
 	if (doFilter && _leSim)
 	{
-		auto mslFinalX = mslX.last();
-		auto mslFinalY = mslY.last();
-		QVector<double> xCoords, yCoords;
-		
-		xCoords.clear(); yCoords.clear();
-		
-		for (auto coordX : hitRadX)
-			xCoords.append(coordX + mslFinalX);
-		
-		for (auto coordY : hitRadY)
-			yCoords.append(coordY + mslFinalY);
-		
+		auto mslFinalX = mslPoints.back().x();
+		auto mslFinalY = mslPoints.back().y();
+		QVector<double> xCoords(hitRadX.size()), yCoords(hitRadY.size());
+
+		for (int i = 0; i < hitRadX.size(); ++i)
+		{
+			xCoords[i] = hitRadX[i] + mslFinalX;
+			yCoords[i] = hitRadY[i] + mslFinalY;
+		}
+
 		auto radCrvCasted = static_cast<QCPCurve*>(radiusCurve);
 		radCrvCasted->setData(xCoords, yCoords);
 		radCrvCasted->setVisible(true);
 	}
 
-	ui->plot->replot();
+	{
+		MGE_TRACE_SCOPE("QCustomPlot::replot");
+		ui->plot->replot();
+	}
+
 	ui->plot->update();
 }
 
 void MainWindow::runSim()
 {
-	while (!simFinished)
+	while (!simFinished && !simCancelRequested)
 	{
 		_leSim->iterate();
 
-		tgtX.append(_leSim->getTarget()->getX());
-		tgtY.append(_leSim->getTarget()->getY());
-		mslX.append(_leSim->getMissile()->getX());
-		mslY.append(_leSim->getMissile()->getY());
+		TrajectorySample sample{ _leSim->getMissile()->getX(), _leSim->getMissile()->getY(), _leSim->getTarget()->getX(), _leSim->getTarget()->getY() };
+
+		// если GUI не успевает забирать точки, ждём, а не теряем их
+		if (!trajectoryChannel.tryPush(sample))
+		{
+			MGE_TRACE_SCOPE("waiting for trajectoryChannel");
 
+			while (!trajectoryChannel.tryPush(sample) && !simCancelRequested)
+				std::this_thread::yield();
+		}
+
+		simProgressTime = _leSim->getElapsedTime();
+		simProgressDistance = _leSim->getMslTgtDistance();
 		simFinished = _leSim->mslWithinTgtHitRadius() || !_leSim->mslSpeedMoreThanTgtSpeed();
 	}
+
+	simFinished = true;
 }
 
-void MainWindow::prepareHitRadData()
+void MainWindow::drainTrajectoryChannel()
 {
-	const static double degreesPerStep{ 0.5 };
-	QVector2D radVector{ float(_leSim->getMslProxyRadius()), 0.f };
-	double currentAngle{ 0 };
+	MGE_TRACE_SCOPE("MainWindow::drainTrajectoryChannel");
+	trajectoryChannel.drain([this](const TrajectorySample& sample) { appendTrajectorySample(sample); });
+}
 
-	hitRadX.append(radVector.x());
-	hitRadY.append(radVector.y());
+void MainWindow::clearTrajectory()
+{
+	auto tolerance = _leSim->getMissile()->getProxyRadius();
+	auto stepCount = _leSim->estimateStepCount();
+	auto duration = _leSim->estimateDuration();
+	auto distance = _leSim->getMslTgtDistance();
+
+	// запас по оценке числа оставленных точек: при записи точек обращений к куче не будет, если оценка не занижена.
+	// ближе TERMINAL_DETAIL_RADII радиусов взрывателя остаются все шаги - их доля пропорциональна длине этого участка;
+	// дальше оставленные отрезки длиннее допуска, так что точек не больше длины пути, делённой на допуск
+	auto terminalShare = distance > 0 ? std::min(tolerance * TERMINAL_DETAIL_RADII / distance, 1.) : 1.;
+	auto terminalCount = std::size_t(std::ceil(stepCount * terminalShare));
+	auto estimatePointCount = [&](double speed)
+	{
+		if (tolerance <= 0)
+			return stepCount;
+
+		return std::min(stepCount, std::size_t(std::ceil(speed * duration / tolerance)) + terminalCount + 1);
+	};
+
+	mslPoints.clear();
+	tgtPoints.clear();
+	mslPoints.reserve(estimatePointCount(_leSim->getMissile()->getSpeed()));
+	tgtPoints.reserve(estimatePointCount(_leSim->getTarget()->getSpeed()));
+	mslDecimator.reset();
+	tgtDecimator.reset();
+	mslDecimator.setTolerance(tolerance);
+	tgtDecimator.setTolerance(tolerance);
+	mslShown = ShownTrajectory();
+	tgtShown = ShownTrajectory();
+	ui->plot->graph(0)->data()->clear();
+	ui->plot->graph(1)->data()->clear();
+}
 
-	while (currentAngle <= 360)
+void MainWindow::appendGraphData(QCPGraph* graph, const SegmentedBuffer<Vec2d>& points, const TrajectoryDecimator& decimator, ShownTrajectory& shown)
+{
+	auto data = graph->data();
+
+	if (shown.hasPending)
 	{
-		currentAngle += degreesPerStep;
-		rotateVec(degreesPerStep, radVector, false);
+		// контейнер упорядочен по x, точки с равным x стоят подряд: хвост меняется местами с первой из них, её и удаляет remove
+		auto sameKey = std::equal_range(data->begin(), data->end(), QCPGraphData(shown.pendingX, 0), qcpLessThanSortKey<QCPGraphData>);
+		auto pending = std::find_if(sameKey.first, sameKey.second, [&shown](const QCPGraphData& point) { return point.value == shown.pendingY; });
 
-		hitRadX.append(radVector.x());
-		hitRadY.append(radVector.y());
+		if (pending != sameKey.second)
+		{
+			std::iter_swap(sameKey.first, pending);
+			data->remove(shown.pendingX);
+		}
+
+		shown.hasPending = false;
+	}
+
+	if (shown.pointCount < points.size())
+	{
+		QVector<QCPGraphData> chunk;
+
+		chunk.reserve(int(points.size() - shown.pointCount));
+		points.forEachChunk(shown.pointCount, points.size(), [&chunk](const Vec2d* segment, std::size_t count)
+		{
+			for (std::size_t i = 0; i < count; ++i)
+				chunk.append(QCPGraphData(segment[i].x(), segment[i].y()));
+		});
+
+		data->add(chunk, false);
+		shown.pointCount = points.size();
+	}
+
+	// пока моделирование идёт, траектория доходит до текущего положения
+	if (decimator.hasPending())
+	{
+		data->add(QCPGraphData(decimator.getPendingX(), decimator.getPendingY()));
+		shown.pendingX = decimator.getPendingX();
+		shown.pendingY = decimator.getPendingY();
+		shown.hasPending = true;
+	}
+}
+
+void MainWindow::appendTrajectorySample(const TrajectorySample& sample)
+{
+	// вблизи цели точки не прореживаются, чтобы геометрия перехвата осталась без искажений
+	if (std::hypot(sample.mslX - sample.tgtX, sample.mslY - sample.tgtY) < _leSim->getMissile()->getProxyRadius() * TERMINAL_DETAIL_RADII)
+	{
+		mslDecimator.setTolerance(0);
+		tgtDecimator.setTolerance(0);
 	}
+
+	mslDecimator.push(sample.mslX, sample.mslY, [this](double x, double y) { mslPoints.push_back(Vec2d(x, y)); });
+	tgtDecimator.push(sample.tgtX, sample.tgtY, [this](double x, double y) { tgtPoints.push_back(Vec2d(x, y)); });
+}
+
+void MainWindow::prepareHitRadData()
+{
+	MGE_TRACE_SCOPE("MainWindow::prepareHitRadData");
+	const static double degreesPerStep{ 0.5 };
+	const static int pointCount{ int(360 / degreesPerStep) + 1 }; // контур замкнут - последняя точка совпадает с первой
+	std::vector<double> angles(pointCount);
+
+	// все точки окружности получаются поворотом радиус-вектора на свой угол за один пакетный вызов, без накопления ошибки
+	for (int i = 0; i < pointCount; ++i)
+		angles[i] = degToRad(i * degreesPerStep);
+
+	hitRadX.fill(_leSim->getMslProxyRadius(), pointCount);
+	hitRadY.fill(0., pointCount);
+	rotateVectorsBatch(angles.data(), hitRadX.data(), hitRadY.data(), pointCount);
 }
 
 void MainWindow::_createLangMenu(void)
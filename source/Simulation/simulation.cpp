@@ -1,14 +1,20 @@
 #include "Simulation/simulation.hpp"
 #include "Simulation/CommonSimParams.hpp"
+#include "Simulation/Auxilary/ClosestApproach.hpp"
+#include "Simulation/Auxilary/PhaseProfiler.hpp"
+#include "Simulation/Auxilary/TraceRecorder.hpp"
+
+#include <algorithm>
 
 Simulation::Simulation()
 {
 	_target = new Target(0, 0, 1e5);
 	_missile = new Missile(0, 0, 0);
 	_missile->setTarget(_target);
+	_missDistance = _getMslTgtDistance();
 }
 
-Simulation::Simulation(QPointF targetLocation, double targetSpeed, QPointF missileLocation, double missileSpeed, bool fileOutputNeeded)
+Simulation::Simulation(Vec2d targetLocation, double targetSpeed, Vec2d missileLocation, double missileSpeed, bool fileOutputNeeded)
 {
 	_fileOutputNeeded = fileOutputNeeded;
 	_target = new Target(targetSpeed, targetLocation.x(), targetLocation.y());
@@ -18,47 +24,209 @@ Simulation::Simulation(QPointF targetLocation, double targetSpeed, QPointF missi
 		_prepOutputFile();
 
 	_missile->setTarget(_target);
+	_missDistance = _getMslTgtDistance();
 }
 
 Simulation::~Simulation()
 {
 	delete _target;
 	delete _missile;
-	if (_outputFile.is_open()) _outputFile.close();
+}
+
+double Simulation::estimateDuration()
+{
+	const static double decelerationMargin{ 1.5 };	// ракета тормозит после выгорания топлива, цель может уходить манёвром
+	const static double minClosingSpeed{ 1. };
+	Vec2d relPosition = _target->getCoordinates() - _missile->getCoordinates();
+	Vec2d relVelocity = _target->getVelocity() - _missile->getVelocity();
+	double distance = relPosition.length();
+	double closingSpeed = distance > 0 ? -dot(relVelocity, relPosition) / distance : 0;
+
+	// при расходящемся движении оценивать не по чему - берём полёт ракеты на всю дальность с её текущей скоростью
+	if (closingSpeed < minClosingSpeed)
+		closingSpeed = std::max(_missile->getSpeed(), minClosingSpeed);
+
+	return distance / closingSpeed * decelerationMargin;
+}
+
+std::size_t Simulation::estimateStepCount()
+{
+	double step = _integration.method == IntegrationMethod::Euler ? SIM_RESOLUTION : _integration.fixedStep;
+
+	return std::size_t(std::ceil(estimateDuration() / step)) + 1;
 }
 
 void Simulation::iterate()
 {
-	if (_fileOutputNeeded)
+	MGE_PROFILE_SCOPE(SimulationTick);
+	MGE_TRACE_SCOPE("Simulation::iterate");
+
+	if (_recorder)
 	{
-		_outputFile << convertDoubleToStringWithPrecision(_target->getX()) + ";"
-			+ convertDoubleToStringWithPrecision(_target->getY()) + ";"
-			+ convertDoubleToStringWithPrecision(_target->getSpeed()) + ";"
-			+ convertDoubleToStringWithPrecision(_missile->getX()) + ";"
-			+ convertDoubleToStringWithPrecision(_missile->getY()) + ";"
-			+ convertDoubleToStringWithPrecision(_missile->getSpeed()) + ";"
-			+ convertDoubleToStringWithPrecision(_simElapsedTime) + ";\n";
+		MGE_PROFILE_SCOPE(TrajectoryAppend);
+		_recordState();
 	}
 
+	Vec2d startRelPosition = _target->getCoordinates() - _missile->getCoordinates();
+	double startTime = _simElapsedTime;
+
+	if (_integration.method == IntegrationMethod::Euler)
+		_advanceEuler();
+	else
+		_advanceRungeKutta();
+
+	_checkEndgame(startRelPosition, startTime);
+	_stepCount++;
+}
+
+void Simulation::seed(std::uint64_t seed)
+{
+	// цель и ракета получают разные, но однозначно определяемые зерном потоки
+	if (_target) _target->reseed(CounterRng::deriveKey(seed, 0));
+	if (_missile) _missile->reseed(CounterRng::deriveKey(seed, 1));
+}
+
+void Simulation::setFileOutputNeededTo(const bool newVal)
+{
+	_fileOutputNeeded = newVal;
+
+	if (!newVal)
+		finishFileOutput(TrajectoryFormat::CloseState::Forced);
+}
+
+void Simulation::startFileOutput()
+{
+	// незакрытая запись прежнего прогона закрывается, время в новом файле снова начинается с нуля
+	finishFileOutput(TrajectoryFormat::CloseState::Forced);
+
+	if (_fileOutputNeeded)
+		_prepOutputFile();
+}
+
+void Simulation::finishFileOutput(TrajectoryFormat::CloseState closeState)
+{
+	if (!_recorder)
+		return;
+
+	// такт записывает состояние до шага - конечное положение дописывается здесь, чтобы запись доходила до перехвата
+	if (closeState == TrajectoryFormat::CloseState::Normal)
+		_recordState();
+
+	_recorder->close(closeState);
+	_recorder.reset();
+}
+
+void Simulation::_advanceEuler()
+{
 	_target->advancedMove(SIM_RESOLUTION);
 	_missile->advancedMove(SIM_RESOLUTION);
 
 	_simElapsedTime += SIM_RESOLUTION;
 }
 
-void Simulation::setFileOutputNeededTo(const bool newVal)
+void Simulation::_advanceRungeKutta()
 {
-	if (newVal && !_outputFile.is_open())
-		_prepOutputFile();
-	else if (_outputFile.is_open())
+	auto derivative = [this](double, const EngagementState& state) { return _getEngagementDerivative(state); };
+	EngagementState state = _getEngagementState();
+	EngagementState newState;
+	double step;
+
+	if (_integration.method == IntegrationMethod::RK4)
+	{
+		step = _limitStep(_integration.fixedStep);
+		newState = Integrators::rk4Step<9>(derivative, _simElapsedTime, state, step);
+	}
+	else
+	{
+		EngagementState error, absTolerance;
+
+		absTolerance.fill(_integration.tolerance);
+
+		while (true)
+		{
+			step = _limitStep(std::clamp(_adaptiveStep, _integration.minStep, _integration.maxStep));
+			newState = Integrators::dormandPrinceStep<9>(derivative, _simElapsedTime, state, step, error);
+
+			double errorNorm = Integrators::errorNorm<9>(error, state, newState, absTolerance, _integration.tolerance);
+
+			_adaptiveStep = step * Integrators::nextStepFactor(errorNorm);
+
+			if (errorNorm <= 1 || step <= _integration.minStep)
+				break;
+
+			_rejectedStepCount++;
+		}
+	}
+
+	_missile->setState({ newState[0], newState[1], newState[2], newState[3], newState[4] }, step);
+	_target->setState({ newState[5], newState[6], newState[7], newState[8] }, step);
+	_missile->updateSeekerLock(); // захват проверяется по состоянию в конце шага
+
+	_simElapsedTime += step;
+}
+
+Simulation::EngagementState Simulation::_getEngagementState()
+{
+	auto missileState = _missile->getState();
+	auto targetState = _target->getState();
+	EngagementState state;
+
+	std::copy(missileState.begin(), missileState.end(), state.begin());
+	std::copy(targetState.begin(), targetState.end(), state.begin() + missileState.size());
+
+	return state;
+}
+
+Simulation::EngagementState Simulation::_getEngagementDerivative(const EngagementState& state)
+{
+	auto missileDerivative = _missile->getDerivative({ state[0], state[1], state[2], state[3], state[4] }, state[5], state[6]);
+	auto targetDerivative = _target->getDerivative({ state[5], state[6], state[7], state[8] });
+	EngagementState derivative;
+
+	std::copy(missileDerivative.begin(), missileDerivative.end(), derivative.begin());
+	std::copy(targetDerivative.begin(), targetDerivative.end(), derivative.begin() + missileDerivative.size());
+
+	return derivative;
+}
+
+double Simulation::_limitStep(double step)
+{
+	// шаг заканчивается на ближайшем разрыве - смене манёвра цели, включении автопилота или выгорании топлива
+	double timeToEvent = std::min(_target->getTimeToManeuverChange(), _missile->getTimeToNextEvent());
+
+	return std::min(step, std::max(timeToEvent, _integration.minStep));
+}
+
+void Simulation::_checkEndgame(const Vec2d& startRelPosition, double startTime)
+{
+	// в пределах шага относительное движение считается прямолинейным и равномерным
+	Vec2d endRelPosition = _target->getCoordinates() - _missile->getCoordinates();
+	double step = _simElapsedTime - startTime;
+	auto approach = findClosestApproach(startRelPosition.x(), startRelPosition.y(), endRelPosition.x(), endRelPosition.y());
+
+	if (approach.distance < _missDistance)
+	{
+		_missDistance = approach.distance;
+		_missTime = startTime + approach.fraction * step;
+	}
+
+	if (!_fuzeTriggered && approach.distance <= _missile->getProxyRadius())
 	{
-		_outputFile << "FILE;HAS;;BEEN;;FORCIBLY;CLOSED;\n";
-		_outputFile.close();
+		_fuzeTriggered = true;
+		_fuzeTime = startTime + std::max(findSphereEntryFraction(startRelPosition.x(), startRelPosition.y(), endRelPosition.x(), endRelPosition.y(), _missile->getProxyRadius()), 0.) * step;
 	}
 }
 
+void Simulation::_recordState()
+{
+	_recorder->append({ _target->getX(), _target->getY(), _target->getSpeed(),
+		_missile->getX(), _missile->getY(), _missile->getSpeed(), _simElapsedTime });
+}
+
 void Simulation::_prepOutputFile()
 {
-	_outputFile.open(OUT_FILE_NAME, ios_base::out | ios_base::trunc);
-	_outputFile << fixed << setprecision(STANDARD_PRECISION) << "Time;Target X;Target Y;Target Speed (m/s);Missile X;Missile Y;Missile Speed (m/s);\n";
+	_recorder = std::make_unique<TrajectoryRecorder>(OUT_TRAJ_FILE_NAME, SIM_RESOLUTION);
+
+	if (!_recorder->isOpen())
+		_recorder.reset();
 }
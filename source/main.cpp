@@ -1,10 +1,26 @@
 #include "Simulation/mainwindow.h"
+#include "Simulation/SimObjects/DescriptorCatalog.hpp"
 
 #include <QApplication>
+#include <QMessageBox>
 
 int main(int argc, char *argv[])
 {
 	QApplication a(argc, argv);
+
+	// справочник описаний загружается до создания первой симуляции
+	DescriptorCatalog::setDatabaseDir((QApplication::applicationDirPath() + "/db").toStdString());
+
+	try
+	{
+		DescriptorCatalog::instance();
+	}
+	catch (const std::exception& e)
+	{
+		QMessageBox::critical(nullptr, QObject::tr("Missile Guidance Sim"), QObject::tr("Failed to load the descriptor database: %1").arg(e.what()));
+		return 1;
+	}
+
 	MainWindow w;
 	w.show();
 	return a.exec();